@@ -0,0 +1,349 @@
+// DspBenchmark.cpp
+// Microbenchmark suite for the synth_core DSP kernels
+// Measures ns/sample and realtime factor of each kernel at several block sizes
+// and prints the results as JSON on stdout, so runs can be diffed or plotted.
+// That the SIMD kernels match the scalar reference is checked by synth_test_kernels
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+#include "SynthEngine.h"
+#include "TripleOscillator.h"
+#include "Oscillator.h"
+#include "OscillatorKernels.h"
+#include "Envelope.h"
+#include "Filter.h"
+#include "StateVariableFilter.h"
+#include "LadderFilter.h"
+
+namespace {
+
+constexpr double SAMPLE_RATE = SynthConstants::DEFAULT_SAMPLE_RATE;
+constexpr long SAMPLES_PER_RUN = 1 << 20;   // Samples processed per timed run
+constexpr int RUNS = 5;                     // Timed runs per case, the fastest one is kept
+constexpr int BLOCK_SIZES[] = { 32, 64, 256, 1024 };
+
+// One measured case
+struct Result {
+    std::string kernel;
+    int blockSize;
+    double nsPerSample;
+    double realtimeFactor;
+};
+
+// Kernel under test: processes one block of 'frames' samples into 'out'
+using Kernel = std::function<void(float* out, int frames)>;
+
+// Keeps the optimizer from discarding the rendered samples
+volatile float sink = 0.0f;
+
+// Time a kernel: one warm-up run, then the best of RUNS timed runs
+Result measure(const std::string& name, int blockSize, const Kernel& kernel) {
+    // Stereo-sized so the full engine chain can render interleaved frames
+    std::vector<float> buffer(static_cast<size_t>(blockSize) * 2);
+    long blocks = std::max(1L, SAMPLES_PER_RUN / blockSize);
+
+    for (long b = 0; b < blocks; b++) {
+        kernel(buffer.data(), blockSize);
+    }
+
+    double best = 1e300;
+    for (int run = 0; run < RUNS; run++) {
+        auto start = std::chrono::steady_clock::now();
+        for (long b = 0; b < blocks; b++) {
+            kernel(buffer.data(), blockSize);
+        }
+        auto end = std::chrono::steady_clock::now();
+        sink = sink + buffer[0];
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+
+    double samples = static_cast<double>(blocks) * blockSize;
+    return { name, blockSize, best * 1e9 / samples, (samples / SAMPLE_RATE) / best };
+}
+
+// Instruction sets with a kernel this CPU can run, scalar first
+std::vector<OscillatorKernels::Isa> supportedIsas() {
+    std::vector<OscillatorKernels::Isa> isas;
+    for (int i = 0; i <= static_cast<int>(OscillatorKernels::detectIsa()); i++) {
+        isas.push_back(static_cast<OscillatorKernels::Isa>(i));
+    }
+    return isas;
+}
+
+// Print all results as a JSON document
+void printJson(const std::vector<Result>& results) {
+    std::printf("{\n  \"sample_rate\": %.0f,\n  \"isa\": \"%s\",\n  \"results\": [\n", SAMPLE_RATE,
+                OscillatorKernels::isaName(OscillatorKernels::detectIsa()));
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        std::printf("    {\"kernel\": \"%s\", \"block_size\": %d, \"ns_per_sample\": %.3f, \"realtime_factor\": %.1f}%s\n",
+                    r.kernel.c_str(), r.blockSize, r.nsPerSample, r.realtimeFactor,
+                    i + 1 < results.size() ? "," : "");
+    }
+    std::printf("  ]\n}\n");
+}
+
+} // namespace
+
+int main() {
+    std::vector<Result> results;
+
+    const std::pair<Oscillator::Waveform, const char*> waveforms[] = {
+        { Oscillator::Waveform::Triangle, "triangle" },
+        { Oscillator::Waveform::Noise, "noise" },
+        { Oscillator::Waveform::Saw, "saw" },
+        { Oscillator::Waveform::Square, "square" },
+        { Oscillator::Waveform::Pulse, "pulse" },
+        { Oscillator::Waveform::PinkNoise, "pink_noise" },
+        { Oscillator::Waveform::BrownNoise, "brown_noise" },
+    };
+
+    for (int blockSize : BLOCK_SIZES) {
+        // Oscillator::processBuffer, once per waveform
+        for (const auto& [waveform, name] : waveforms) {
+            Oscillator osc;
+            osc.setSampleRate(SAMPLE_RATE);
+            osc.setFrequency(440.0);
+            osc.setWaveform(waveform);
+            results.push_back(measure(std::string("oscillator/") + name, blockSize,
+                [&](float* out, int frames) { osc.processBuffer(out, frames); }));
+        }
+
+        // Wavetable kernel per instruction set (saw at 440 Hz), to compare the widths
+        for (OscillatorKernels::Isa isa : supportedIsas()) {
+            OscillatorKernels::TableKernel kernel = OscillatorKernels::tableKernel(isa);
+            const auto step = static_cast<uint32_t>(440.0 / SAMPLE_RATE * SynthConstants::PHASE_CYCLE);
+            const float* table = Wavetable::instance().select(Wavetable::Shape::Saw, static_cast<double>(step) / SynthConstants::PHASE_CYCLE);
+            uint32_t phase = 0;
+            results.push_back(measure(std::string("oscillator_kernel/") + OscillatorKernels::isaName(isa), blockSize,
+                [&](float* out, int frames) { phase = kernel(table, phase, step, nullptr, 0.5f, out, frames); }));
+        }
+
+        // Supersaw: a full unison stack spread across both channels
+        {
+            Oscillator osc;
+            osc.setSampleRate(SAMPLE_RATE);
+            osc.setFrequency(440.0);
+            osc.setWaveform(Oscillator::Waveform::Saw);
+            osc.setUnison(SynthConstants::MAX_UNISON);
+            osc.setUnisonDetune(50.0f);
+            osc.setUnisonSpread(1.0f);
+            results.push_back(measure("oscillator/saw_unison_" + std::to_string(SynthConstants::MAX_UNISON), blockSize,
+                [&](float* out, int frames) { osc.processBuffer(out, out + frames, frames); }));
+        }
+
+        // Envelope::processBlock inside a moving segment (an attack too long to finish)
+        for (Envelope::Curve curve : { Envelope::Curve::Linear, Envelope::Curve::Exponential }) {
+            Envelope env;
+            env.setSampleRate(static_cast<float>(SAMPLE_RATE));
+            env.setCurve(curve);
+            env.setAttack(1.0e6f);
+            env.noteOn();
+            results.push_back(measure(curve == Envelope::Curve::Linear ? "envelope/linear" : "envelope/exponential", blockSize,
+                [&](float* out, int frames) { env.processBlock(out, frames); }));
+        }
+
+        // LowPassFilter::process with the cutoff LFO off and on
+        for (bool lfo : { false, true }) {
+            LowPassFilter filter(static_cast<float>(SAMPLE_RATE));
+            filter.setCutoff(2000.0f);
+            filter.setResonance(0.5f);
+            filter.setAutoVariationFrequency(5.0f);
+            filter.setAutoVariationAmount(lfo ? 0.5f : 0.0f);
+            float input = 0.0f;  // 100 Hz-ish ramp: a realistic, non-decaying input
+            results.push_back(measure(lfo ? "filter/lfo_on" : "filter/lfo_off", blockSize,
+                [&](float* out, int frames) {
+                    for (int i = 0; i < frames; i++) {
+                        input += 0.005f;
+                        if (input > 0.5f) input -= 1.0f;
+                        out[i] = filter.process(input);
+                    }
+                }));
+        }
+
+        // StateVariableFilter::processBlock: fixed cutoff, cutoff LFO, and a cutoff per sample
+        for (const char* variant : { "svf", "svf_lfo", "svf_audio_rate" }) {
+            StateVariableFilter filter(static_cast<float>(SAMPLE_RATE));
+            filter.setCutoff(2000.0f);
+            filter.setResonance(0.5f);
+            filter.setAutoVariationFrequency(5.0f);
+            filter.setAutoVariationAmount(std::strcmp(variant, "svf_lfo") == 0 ? 0.5f : 0.0f);
+            bool audioRate = std::strcmp(variant, "svf_audio_rate") == 0;
+            std::vector<float> cutoffs(static_cast<size_t>(blockSize));
+            float input = 0.0f;
+            float sweep = 0.0f;  // Cutoff swept 1-3 kHz at the same rate as the input ramp
+            results.push_back(measure(std::string("filter/") + variant, blockSize,
+                [&](float* out, int frames) {
+                    for (int i = 0; i < frames; i++) {
+                        input += 0.005f;
+                        if (input > 0.5f) input -= 1.0f;
+                        out[i] = input;
+                        sweep += 0.005f;
+                        if (sweep > 1.0f) sweep -= 1.0f;
+                        cutoffs[i] = 1000.0f + 2000.0f * sweep;
+                    }
+                    if (audioRate) filter.processBlock(out, cutoffs.data(), frames);
+                    else filter.processBlock(out, frames);
+                }));
+        }
+
+        // LadderFilter::processBlock on a stereo pair (as in the engine) at each oversampling
+        // factor, and on a full bank: ns_per_sample is per frame of all lanes
+        for (int lanes : { 2, LadderFilter::LANES }) {
+            for (int oversampling : { 1, 2, 4 }) {
+                if (lanes == LadderFilter::LANES && oversampling != 2) continue;
+                LadderFilter filter(static_cast<float>(SAMPLE_RATE));
+                filter.setCutoff(2000.0f);
+                filter.setResonance(0.5f);
+                filter.setDrive(2.0f);
+                filter.setOversampling(oversampling);
+                std::vector<float> channelData(static_cast<size_t>(blockSize) * lanes);
+                std::vector<float*> channels;
+                for (int l = 0; l < lanes; l++) channels.push_back(channelData.data() + l * blockSize);
+                float input = 0.0f;
+                results.push_back(measure("filter/ladder_" + std::to_string(oversampling) + "x_"
+                                          + std::to_string(lanes) + "_lanes", blockSize,
+                    [&](float* out, int frames) {
+                        for (int i = 0; i < frames; i++) {
+                            input += 0.005f;
+                            if (input > 0.5f) input -= 1.0f;
+                            for (int l = 0; l < lanes; l++) channels[l][i] = input;
+                        }
+                        filter.processBlock(channels.data(), lanes, frames);
+                        out[0] = channels[0][0];
+                    }));
+            }
+        }
+
+        // TripleOscillator::processBuffer with all three oscillators enabled
+        {
+            TripleOscillator triple;
+            triple.setSampleRate(SAMPLE_RATE);
+            triple.setFrequency(440.0);
+            triple.setOsc2Enabled(true);
+            triple.setOsc3Enabled(true);
+            triple.noteOn();
+            results.push_back(measure("triple_oscillator", blockSize,
+                [&](float* out, int frames) { triple.processBuffer(out, frames); }));
+        }
+
+        // TripleOscillator::processBuffer with the default patch: only osc1 enabled
+        {
+            TripleOscillator triple;
+            triple.setSampleRate(SAMPLE_RATE);
+            triple.setFrequency(440.0);
+            triple.noteOn();
+            results.push_back(measure("triple_oscillator/1_osc", blockSize,
+                [&](float* out, int frames) { triple.processBuffer(out, frames); }));
+        }
+
+        // TripleOscillator::processBuffer with each FM algorithm (sine-like triangle operators)
+        const std::pair<TripleOscillator::Algorithm, const char*> algorithms[] = {
+            { TripleOscillator::Algorithm::Stack, "stack" },
+            { TripleOscillator::Algorithm::Dual, "dual" },
+            { TripleOscillator::Algorithm::Split, "split" },
+        };
+        for (const auto& [algorithm, name] : algorithms) {
+            TripleOscillator triple;
+            triple.setSampleRate(SAMPLE_RATE);
+            triple.setFrequency(440.0);
+            triple.setOsc2Enabled(true);
+            triple.setOsc3Enabled(true);
+            triple.setOsc2Waveform(Oscillator::Waveform::Triangle);
+            triple.setOsc3Waveform(Oscillator::Waveform::Triangle);
+            triple.setOsc2ModIndex(2.0f);
+            triple.setOsc3ModIndex(1.0f);
+            triple.setAlgorithm(algorithm);
+            triple.noteOn();
+            results.push_back(measure(std::string("triple_oscillator/fm_") + name, blockSize,
+                [&](float* out, int frames) { triple.processBuffer(out, frames); }));
+        }
+
+        // Full chain with nothing playing: the idle short-circuit, LFO still running
+        {
+            SynthParamsBuffer params;
+            SynthParams patch;
+            patch.filter_auto_variation_amount = 0.5f;
+            params.publish(patch);
+
+            SynthEngine engine(&params, SAMPLE_RATE);
+            results.push_back(measure("engine/idle", blockSize,
+                [&](float* out, int frames) { engine.render(out, static_cast<unsigned long>(frames)); }));
+        }
+
+        // Full audioCallback chain: events, oscillators, envelope, filter, volume, stereo output
+        {
+            SynthParamsBuffer params;
+            SynthParams patch;
+            patch.filter_cutoff = 2000.0f;
+            patch.filter_resonance = 0.5f;
+            params.publish(patch);
+
+            SynthEngine engine(&params, SAMPLE_RATE);
+            engine.postEvent({SynthEvent::Type::SetOscEnabled, 1, 1.0});
+            engine.postEvent({SynthEvent::Type::SetOscEnabled, 2, 1.0});
+            SynthEvent noteOn { SynthEvent::Type::NoteOn };
+            noteOn.note = 69;
+            engine.postEvent(noteOn);
+            results.push_back(measure("engine/render", blockSize,
+                [&](float* out, int frames) { engine.render(out, static_cast<unsigned long>(frames)); }));
+        }
+
+        // Full chain under automation: volume, cutoff and resonance retargeted every block,
+        // so they are always gliding and the filter recomputes its coefficients each grid block
+        {
+            SynthParamsBuffer params;
+            SynthParams patch;
+            patch.filter_cutoff = 2000.0f;
+            patch.filter_resonance = 0.5f;
+            params.publish(patch);
+
+            SynthEngine engine(&params, SAMPLE_RATE);
+            engine.postEvent({SynthEvent::Type::SetOscEnabled, 1, 1.0});
+            engine.postEvent({SynthEvent::Type::SetOscEnabled, 2, 1.0});
+            SynthEvent noteOn { SynthEvent::Type::NoteOn };
+            noteOn.note = 69;
+            engine.postEvent(noteOn);
+            bool up = false;
+            results.push_back(measure("engine/render_automated", blockSize,
+                [&](float* out, int frames) {
+                    up = !up;
+                    patch.volume = up ? 0.6f : 0.4f;
+                    patch.filter_cutoff = up ? 3000.0f : 1000.0f;
+                    patch.filter_resonance = up ? 0.6f : 0.4f;
+                    params.publish(patch);
+                    engine.render(out, static_cast<unsigned long>(frames));
+                }));
+        }
+
+        // Full chain with the whole voice pool sounding
+        {
+            SynthParamsBuffer params;
+            SynthParams patch;
+            patch.filter_cutoff = 2000.0f;
+            patch.filter_resonance = 0.5f;
+            patch.voice_count = SynthConstants::MAX_VOICES;
+            params.publish(patch);
+
+            SynthEngine engine(&params, SAMPLE_RATE);
+            engine.postEvent({SynthEvent::Type::SetOscEnabled, 1, 1.0});
+            engine.postEvent({SynthEvent::Type::SetOscEnabled, 2, 1.0});
+            for (int v = 0; v < SynthConstants::MAX_VOICES; v++) {
+                SynthEvent noteOn { SynthEvent::Type::NoteOn };
+                noteOn.note = 45 + v;
+                engine.postEvent(noteOn);
+            }
+            results.push_back(measure("engine/render_" + std::to_string(SynthConstants::MAX_VOICES) + "_voices", blockSize,
+                [&](float* out, int frames) { engine.render(out, static_cast<unsigned long>(frames)); }));
+        }
+    }
+
+    printJson(results);
+    return 0;
+}
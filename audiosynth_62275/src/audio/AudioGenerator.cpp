@@ -1,137 +1,283 @@
 #include "include/AudioGenerator.h"
+#include <algorithm>
 #include <cmath>
+#include <iostream>
 
-constexpr int FRAMES_PER_BUFFER = 256;
+namespace {
+
+// Notes held back while the event queue is full; past this, they are replaced by
+// a single all-notes-off so no voice is left hanging
+constexpr size_t MAX_PENDING_NOTES = 64;
+
+} // namespace
 
 // Constructor: initializes synth modules with sample rate
-AudioGenerator::AudioGenerator(SynthParams* params) 
+AudioGenerator::AudioGenerator(SynthParamsBuffer* params) 
     : stream(nullptr), 
-      params(params), 
-      filter(SynthConstants::SAMPLE_RATE) {}
+      engine(params),
+      lastEventFrame(0) {}
 
 // Destructor: ensures audio stream is stopped
 AudioGenerator::~AudioGenerator() { 
     stop(); 
 }
 
-// Initialize audio stream
-void AudioGenerator::init() {
-    std::lock_guard<std::mutex> lock(mutex);
-    
+// Initialize audio stream with the given sample rate and latency profile
+void AudioGenerator::init(const AudioConfig& audioConfig) {
     PaError err = Pa_Initialize();
     if (err != paNoError) {
         return;
     }
+    openStream(audioConfig);
+}
+
+// Stop audio stream and clean up
+void AudioGenerator::stop() {
+    closeStream();
+    Pa_Terminate();
+}
+
+// Switch sample rate / latency profile live: reopens the stream
+bool AudioGenerator::setAudioConfig(const AudioConfig& audioConfig) {
+    AudioConfig previous = config;
+    closeStream();
+    if (openStream(audioConfig)) {
+        return true;
+    }
+    openStream(previous);
+    return false;
+}
+
+const AudioConfig& AudioGenerator::getAudioConfig() const {
+    return config;
+}
+
+// Retune every MIDI note: the engine takes the new table at its next block,
+// so the stream keeps running
+void AudioGenerator::setTuning(const Tuning& tuning) {
+    engine.setTuning(tuning);
+}
 
-    // Open default audio output stream (stereo, 32-bit float, with callback)
-    err = Pa_OpenDefaultStream(&stream,
-                              0,          // No input channels
-                              2,          // Stereo output (2 channels)
-                              paFloat32,  // 32-bit float audio format
-                              SynthConstants::SAMPLE_RATE,
-                              FRAMES_PER_BUFFER,
-                              audioCallback,
-                              this);      // Pass this object to callback
+// Open and start a stream for the given configuration, returns false on failure
+bool AudioGenerator::openStream(const AudioConfig& audioConfig) {
+    PaDeviceIndex device = Pa_GetDefaultOutputDevice();
+    if (device == paNoDevice) {
+        return false;
+    }
+    const PaDeviceInfo* info = Pa_GetDeviceInfo(device);
+
+    // Map the latency profile to a buffer size and a latency hint for the driver.
+    // Buffer sizes scale with the sample rate so each profile keeps its latency in ms.
+    unsigned long rateScale = std::max(1L, std::lround(audioConfig.sampleRate / 48000.0));
+    unsigned long framesPerBuffer = SynthConstants::FRAMES_PER_BUFFER;
+    double suggestedLatency = info->defaultLowOutputLatency;
+    switch (audioConfig.latency) {
+        case LatencyProfile::LowLatency:
+            framesPerBuffer = 64 * rateScale;
+            suggestedLatency = info->defaultLowOutputLatency;
+            break;
+        case LatencyProfile::Balanced:
+            framesPerBuffer = 256 * rateScale;
+            suggestedLatency = std::max(info->defaultLowOutputLatency,
+                                        2.0 * framesPerBuffer / audioConfig.sampleRate);
+            break;
+        case LatencyProfile::PowerSave:
+            framesPerBuffer = 1024 * rateScale;
+            suggestedLatency = info->defaultHighOutputLatency;
+            break;
+    }
 
+    PaStreamParameters output;
+    output.device = device;
+    output.channelCount = 2;                // Stereo output (2 channels)
+    output.sampleFormat = paFloat32;        // 32-bit float audio format
+    output.suggestedLatency = suggestedLatency;
+    output.hostApiSpecificStreamInfo = nullptr;
+
+    // The audio thread is not running here, so the engine can be retuned directly
+    engine.setSampleRate(audioConfig.sampleRate);
+
+    // Open output stream (no input, with callback)
+    PaError err = Pa_OpenStream(&stream,
+                                nullptr,    // No input channels
+                                &output,
+                                audioConfig.sampleRate,
+                                framesPerBuffer,
+                                paNoFlag,
+                                audioCallback,
+                                this);      // Pass this object to callback
     if (err != paNoError) {
-        return;
+        stream = nullptr;
+        return false;
     }
 
     // Start audio stream
     err = Pa_StartStream(stream);
     if (err != paNoError) {
-        return;
+        Pa_CloseStream(stream);
+        stream = nullptr;
+        return false;
     }
+
+    config = audioConfig;
+    return true;
 }
 
-// Stop audio stream and clean up
-void AudioGenerator::stop() {
-    std::lock_guard<std::mutex> lock(mutex);
-    
+// Stop and close the current stream, if any
+void AudioGenerator::closeStream() {
     if (stream) {
         Pa_StopStream(stream);
         Pa_CloseStream(stream);
         stream = nullptr;
     }
-    Pa_Terminate();
-}
-
-// Synth parameter setters: forward calls to TripleOscillator with thread-safety
-void AudioGenerator::setFrequency(double freq) { 
-    std::lock_guard<std::mutex> lock(mutex);
-    oscillator.setFrequency(freq); 
 }
 
+// Synth parameter setters: post timestamped events to the audio thread (never block)
 void AudioGenerator::setOsc1Enabled(bool enabled) { 
-    std::lock_guard<std::mutex> lock(mutex);
-    oscillator.setOsc1Enabled(enabled); 
+    post({SynthEvent::Type::SetOscEnabled, 0, enabled ? 1.0 : 0.0});
 }
 
 void AudioGenerator::setOsc1Waveform(Oscillator::Waveform wf) { 
-    std::lock_guard<std::mutex> lock(mutex);
-    oscillator.setOsc1Waveform(wf); 
+    post({SynthEvent::Type::SetOscWaveform, 0, static_cast<double>(wf)});
 }
 
 void AudioGenerator::setOsc1FrequencyOffset(float offset) { 
-    std::lock_guard<std::mutex> lock(mutex);
-    oscillator.setOsc1FrequencyOffset(offset); 
+    post({SynthEvent::Type::SetOscFrequencyOffset, 0, offset});
 }
 
 void AudioGenerator::setOsc2Enabled(bool enabled) { 
-    std::lock_guard<std::mutex> lock(mutex);
-    oscillator.setOsc2Enabled(enabled); 
+    post({SynthEvent::Type::SetOscEnabled, 1, enabled ? 1.0 : 0.0});
 }
 
 void AudioGenerator::setOsc2Waveform(Oscillator::Waveform wf) { 
-    std::lock_guard<std::mutex> lock(mutex);
-    oscillator.setOsc2Waveform(wf); 
+    post({SynthEvent::Type::SetOscWaveform, 1, static_cast<double>(wf)});
 }
 
 void AudioGenerator::setOsc2FrequencyOffset(float offset) { 
-    std::lock_guard<std::mutex> lock(mutex);
-    oscillator.setOsc2FrequencyOffset(offset); 
+    post({SynthEvent::Type::SetOscFrequencyOffset, 1, offset});
 }
 
 void AudioGenerator::setOsc3Enabled(bool enabled) { 
-    std::lock_guard<std::mutex> lock(mutex);
-    oscillator.setOsc3Enabled(enabled); 
+    post({SynthEvent::Type::SetOscEnabled, 2, enabled ? 1.0 : 0.0});
 }
 
 void AudioGenerator::setOsc3Waveform(Oscillator::Waveform wf) { 
-    std::lock_guard<std::mutex> lock(mutex);
-    oscillator.setOsc3Waveform(wf); 
+    post({SynthEvent::Type::SetOscWaveform, 2, static_cast<double>(wf)});
 }
 
 void AudioGenerator::setOsc3FrequencyOffset(float offset) { 
-    std::lock_guard<std::mutex> lock(mutex);
-    oscillator.setOsc3FrequencyOffset(offset); 
+    post({SynthEvent::Type::SetOscFrequencyOffset, 2, offset});
+}
+
+void AudioGenerator::setOsc1Unison(int count) {
+    post({SynthEvent::Type::SetOscUnison, 0, static_cast<double>(count)});
+}
+
+void AudioGenerator::setOsc1UnisonDetune(float cents) {
+    post({SynthEvent::Type::SetOscUnisonDetune, 0, cents});
 }
 
-void AudioGenerator::setAttack(float a) { 
-    std::lock_guard<std::mutex> lock(mutex);
-    oscillator.setAttack(a); 
+void AudioGenerator::setOsc1UnisonSpread(float spread) {
+    post({SynthEvent::Type::SetOscUnisonSpread, 0, spread});
 }
 
-void AudioGenerator::setRelease(float r) { 
-    std::lock_guard<std::mutex> lock(mutex);
-    oscillator.setRelease(r); 
+void AudioGenerator::setOsc2Unison(int count) {
+    post({SynthEvent::Type::SetOscUnison, 1, static_cast<double>(count)});
 }
 
-void AudioGenerator::noteOn() { 
-    std::lock_guard<std::mutex> lock(mutex);
-    oscillator.noteOn(); 
+void AudioGenerator::setOsc2UnisonDetune(float cents) {
+    post({SynthEvent::Type::SetOscUnisonDetune, 1, cents});
 }
 
-void AudioGenerator::noteOff() { 
-    std::lock_guard<std::mutex> lock(mutex);
-    oscillator.noteOff(); 
+void AudioGenerator::setOsc2UnisonSpread(float spread) {
+    post({SynthEvent::Type::SetOscUnisonSpread, 1, spread});
+}
+
+void AudioGenerator::setOsc3Unison(int count) {
+    post({SynthEvent::Type::SetOscUnison, 2, static_cast<double>(count)});
+}
+
+void AudioGenerator::setOsc3UnisonDetune(float cents) {
+    post({SynthEvent::Type::SetOscUnisonDetune, 2, cents});
+}
+
+void AudioGenerator::setOsc3UnisonSpread(float spread) {
+    post({SynthEvent::Type::SetOscUnisonSpread, 2, spread});
+}
+
+void AudioGenerator::setAlgorithm(TripleOscillator::Algorithm algorithm) {
+    post({SynthEvent::Type::SetAlgorithm, 0, static_cast<double>(algorithm)});
+}
+
+void AudioGenerator::setOsc2ModIndex(float index) {
+    post({SynthEvent::Type::SetOscModIndex, 1, index});
+}
+
+void AudioGenerator::setOsc3ModIndex(float index) {
+    post({SynthEvent::Type::SetOscModIndex, 2, index});
+}
+
+void AudioGenerator::noteOn(int note) { 
+    SynthEvent event { SynthEvent::Type::NoteOn };
+    event.note = note;
+    post(event);
+}
+
+void AudioGenerator::noteOff(int note) { 
+    SynthEvent event { SynthEvent::Type::NoteOff };
+    event.note = note;
+    post(event);
+}
+
+// Stamp an event with the engine frame for "now" and queue it for the audio thread
+// Notes that do not fit in the queue are held back and retried, in order, before the
+// next event; a parameter that does not fit is dropped, the next move of its control resends it
+void AudioGenerator::post(SynthEvent event) {
+    // Keep stamps monotonic so events are never reordered by clock jitter
+    lastEventFrame = std::max(lastEventFrame, engine.frameTime());
+    event.frame = lastEventFrame;
+
+    // Notes held back go first, so a later event never overtakes them
+    if (flushPendingNotes() && engine.postEvent(event)) {
+        return;
+    }
+    if (event.type == SynthEvent::Type::NoteOn || event.type == SynthEvent::Type::NoteOff) {
+        holdNote(event);
+    } else {
+        std::cerr << "Synth event queue full, parameter change dropped" << std::endl;
+    }
+}
+
+// Retry the notes held back by post(), oldest first; returns true once none are left
+bool AudioGenerator::flushPendingNotes() {
+    while (!pendingNotes.empty()) {
+        if (!engine.postEvent(pendingNotes.front())) {
+            return false;
+        }
+        pendingNotes.pop_front();
+    }
+    return true;
+}
+
+// Hold back a note the queue had no room for
+void AudioGenerator::holdNote(const SynthEvent& event) {
+    if (pendingNotes.size() < MAX_PENDING_NOTES) {
+        pendingNotes.push_back(event);
+        return;
+    }
+    // Too many to keep: releasing everything is better than leaving a note stuck on
+    std::cerr << "Synth event queue full, " << pendingNotes.size() + 1
+              << " notes dropped, releasing all notes" << std::endl;
+    SynthEvent allOff { SynthEvent::Type::NoteOff };
+    allOff.note = -1;
+    allOff.frame = event.frame;
+    pendingNotes.clear();
+    pendingNotes.push_back(allOff);
 }
 
 // Implementation of static utility function
-double AudioGenerator::calculateNoteFrequency(int noteNumber, int octave) {
-    // Calculate frequency using the formula: 220 * 2^(octave + numeroNote/12.0)
-    // where numeroNote varies from 0 to 12 and octave varies between -2 and +1
-    return 220.0 * std::pow(2.0, octave + noteNumber / 12.0);
+int AudioGenerator::calculateMidiNote(int noteNumber, int octave) {
+    return 57 + 12 * octave + noteNumber;
 }
 
 // PortAudio callback function (called repeatedly to fill audio buffer)
@@ -144,59 +290,9 @@ int AudioGenerator::audioCallback(const void *inputBuffer,
     // Cast userData to AudioGenerator*
     auto* generator = static_cast<AudioGenerator*>(userData);
     auto* out = static_cast<float*>(outputBuffer); // Output buffer
-    float buffer[FRAMES_PER_BUFFER];               // Temporary mono buffer
-
-    // Default values (will be updated from params)
-    float filterCutoff = 20000.0f;
-    float filterResonance = 0.0f;
-    float filterAutoVariationFreq = 0.0f;
-    float filterAutoVariationAmount = 0.0f;
-
-    float volume = 1.0f;
-
-    // Read synth parameters safely (protected by mutex)
-    {
-        std::lock_guard<std::mutex> lock(generator->params->mutex);
-
-        // Update oscillator and envelope parameters
-        generator->oscillator.setFrequency(generator->params->frequency);
-        generator->oscillator.setAttack(generator->params->attack);
-        generator->oscillator.setRelease(generator->params->release);
-        generator->oscillator.setEnvSampleRate(SynthConstants::SAMPLE_RATE);
-
-        // Get filter and volume parameters
-        filterCutoff = generator->params->filter_cutoff;
-        filterResonance = generator->params->filter_resonance;
-        filterAutoVariationFreq = generator->params->filter_auto_variation_frequency;
-        filterAutoVariationAmount = generator->params->filter_auto_variation_amount;
-        volume = generator->params->volume;
-    }
 
-    // Process oscillators: generate raw audio buffer
-    generator->oscillator.processBuffer(buffer, FRAMES_PER_BUFFER);
-
-    // Apply low-pass filter parameters
-    generator->filter.setCutoff(filterCutoff);
-    generator->filter.setResonance(filterResonance);
-    generator->filter.setAutoVariationFrequency(filterAutoVariationFreq);
-    generator->filter.setAutoVariationAmount(filterAutoVariationAmount);
-
-    // Process each sample through the effects chain
-    for (unsigned long i = 0; i < framesPerBuffer; i++) {
-        float sample = buffer[i];
-        
-        // Apply filter
-        sample = generator->filter.process(sample);
-        
-
-        
-        // Apply volume control
-        sample = sample * volume;
-        
-        // Convert to stereo (duplicate mono to both channels)
-        out[i * 2] = sample;     // Left channel
-        out[i * 2 + 1] = sample; // Right channel
-    }
+    // Render the synth engine straight into the interleaved stereo output
+    generator->engine.render(out, framesPerBuffer);
 
     return paContinue;
 }
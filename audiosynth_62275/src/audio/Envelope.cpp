@@ -1,47 +1,201 @@
 #include "include/Envelope.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Exponential segments aim past their end level so they arrive in finite time:
+// the attack at 1 + ATTACK_OVERSHOOT, decay and release just beyond their level
+constexpr double ATTACK_OVERSHOOT = 0.3;
+constexpr double TAIL_OVERSHOOT = 0.0001;  // About -80 dB
+
+// Per-sample factor of an exponential segment that covers full scale in 'time' seconds
+double exponentialCoef(float time, float sampleRate, double overshoot) {
+    if (time <= 0.0f) return 0.0;
+    return std::exp(-std::log((1.0 + overshoot) / overshoot) / (time * sampleRate));
+}
+
+// Advance one segment until it passes its target or the block ends; returns the index reached
+// Linear segments skip the multiply by coef = 1 (same result, half the dependency chain)
+template <bool Rising, bool Linear>
+int runSegment(float& level, float coef, float base, float target, float* gains, int i, int count) {
+    for (; i < count; i++) {
+        level = Linear ? level + base : level * coef + base;
+        if (Rising ? level >= target : level <= target) break;
+        gains[i] = level;
+    }
+    return i;
+}
+
+} // namespace
+
+// Constructor: coefficients for the default times
+Envelope::Envelope() {
+    updateCoefficients();
+}
 
 // Set attack time in seconds
 void Envelope::setAttack(float a) {
-    std::lock_guard<std::mutex> lock(mutex);
+    if (a == attack) return;
     attack = a;
+    updateCoefficients();
+}
+
+// Set decay time in seconds
+void Envelope::setDecay(float d) {
+    if (d == decay) return;
+    decay = d;
+    updateCoefficients();
+}
+
+// Set sustain level (0 to 1)
+// A held note glides to the new level over the decay time
+void Envelope::setSustain(float s) {
+    s = std::clamp(s, 0.0f, 1.0f);
+    if (s == sustain) return;
+    sustain = s;
+    if (stage == Stage::Decay || stage == Stage::Sustain) {
+        enterStage(Stage::Decay);
+    }
 }
 
 // Set release time in seconds
 void Envelope::setRelease(float r) {
-    std::lock_guard<std::mutex> lock(mutex);
+    if (r == release) return;
     release = r;
+    updateCoefficients();
 }
 
-// Start a new note
+// Set the segment shape
+void Envelope::setCurve(Curve c) {
+    if (c == curve) return;
+    curve = c;
+    updateCoefficients();
+}
+
+// Start a new note (the attack starts from the current level)
 void Envelope::noteOn() {
-    std::lock_guard<std::mutex> lock(mutex);
-    gate = true;
+    enterStage(Stage::Attack);
 }
 
 // Release the current note
 void Envelope::noteOff() {
-    std::lock_guard<std::mutex> lock(mutex);
-    gate = false;
+    if (stage == Stage::Idle) return;
+    enterStage(envelope > 0.0f ? Stage::Release : Stage::Idle);
 }
 
 // Process the envelope and return current amplitude
 float Envelope::process() {
-    std::lock_guard<std::mutex> lock(mutex);
-    float attackStep = (attack > 0.0f) ? (1.0f / (attack * sampleRate)) : 1.0f;
-    float releaseStep = (release > 0.0f) ? (1.0f / (release * sampleRate)) : 1.0f;
-    
-    if (gate) {
-        envelope += attackStep;
-        if (envelope > 1.0f) envelope = 1.0f;
-    } else {
-        envelope -= releaseStep;
-        if (envelope < 0.0f) envelope = 0.0f;
+    float gain;
+    processBlock(&gain, 1);
+    return gain;
+}
+
+// Fill gains with the next count envelope values
+// Held levels are a fill; moving segments run the multiply-add until they reach their end
+void Envelope::processBlock(float* gains, int count) {
+    int i = 0;
+    while (i < count) {
+        if (stage == Stage::Idle || stage == Stage::Sustain) {
+            std::fill(gains + i, gains + count, envelope);
+            return;
+        }
+
+        // Local copy: the level stays in a register instead of aliasing gains
+        float level = envelope;
+        bool linear = curve == Curve::Linear;
+        if (rising) {
+            i = linear ? runSegment<true, true>(level, coef, base, target, gains, i, count)
+                       : runSegment<true, false>(level, coef, base, target, gains, i, count);
+        } else {
+            i = linear ? runSegment<false, true>(level, coef, base, target, gains, i, count)
+                       : runSegment<false, false>(level, coef, base, target, gains, i, count);
+        }
+        envelope = level;
+
+        // The segment ended inside the block: clamp to its end level and move on
+        if (i < count) {
+            finishStage();
+            gains[i++] = envelope;
+        }
     }
+}
+
+// Current amplitude, without advancing the envelope
+float Envelope::getLevel() const {
     return envelope;
 }
 
+// True while the gate is on or the release has not reached zero
+bool Envelope::isActive() const {
+    return stage != Stage::Idle;
+}
+
 // Set the sample rate for timing calculations
 void Envelope::setSampleRate(float sr) {
-    std::lock_guard<std::mutex> lock(mutex);
     sampleRate = sr;
+    updateCoefficients();
+}
+
+// Recompute every segment's coefficients (exp, log and divisions kept out of the render loop)
+// Linear segments have coef = 1 and move by a fixed step per sample
+void Envelope::updateCoefficients() {
+    const float times[] = { 0.0f, attack, decay, 0.0f, release };
+    for (int s = static_cast<int>(Stage::Attack); s <= static_cast<int>(Stage::Release); s++) {
+        if (s == static_cast<int>(Stage::Sustain)) continue;
+        if (curve == Curve::Linear) {
+            coefs[s] = 1.0f;
+            steps[s] = (times[s] > 0.0f) ? (1.0f / (times[s] * sampleRate)) : 1.0f;
+        } else {
+            double overshoot = s == static_cast<int>(Stage::Attack) ? ATTACK_OVERSHOOT : TAIL_OVERSHOOT;
+            coefs[s] = static_cast<float>(exponentialCoef(times[s], sampleRate, overshoot));
+        }
+    }
+    // Retime the segment in progress from its current level
+    if (stage != Stage::Idle && stage != Stage::Sustain) {
+        enterStage(stage);
+    }
+}
+
+// Switch stage and load its coefficients
+// The direction is taken from the current level, so decay also rises to a raised sustain
+void Envelope::enterStage(Stage s) {
+    stage = s;
+    switch (s) {
+        case Stage::Idle:
+            envelope = 0.0f;
+            return;
+        case Stage::Sustain:
+            return;
+        case Stage::Attack:
+            target = 1.0f;
+            break;
+        case Stage::Decay:
+            target = sustain;
+            break;
+        case Stage::Release:
+            target = 0.0f;
+            break;
+    }
+
+    int index = static_cast<int>(s);
+    rising = envelope < target;
+    coef = coefs[index];
+    if (curve == Curve::Linear) {
+        base = rising ? steps[index] : -steps[index];
+    } else {
+        double overshoot = s == Stage::Attack ? ATTACK_OVERSHOOT : TAIL_OVERSHOOT;
+        double aim = rising ? target + overshoot : target - overshoot;
+        base = static_cast<float>(aim * (1.0 - coef));
+    }
+}
+
+// Move on once the current segment has reached its end level
+void Envelope::finishStage() {
+    envelope = target;
+    switch (stage) {
+        case Stage::Attack: enterStage(Stage::Decay); break;
+        case Stage::Decay: enterStage(Stage::Sustain); break;
+        default: enterStage(Stage::Idle); break;
+    }
 }
@@ -1,6 +1,17 @@
 #include "include/Filter.h"
+#include "include/SynthConstants.h"
+#include <algorithm>
 #include <cmath>
 
+namespace {
+
+// History level below which the filter output is treated as silence (about -140 dB)
+constexpr float SILENCE_THRESHOLD = 1.0e-7f;
+
+constexpr int INTERVAL = SynthConstants::CONTROL_INTERVAL;
+
+} // namespace
+
 // Constructor initializing sample rate and default parameters
 LowPassFilter::LowPassFilter(float sampleRate)
     : sampleRate(sampleRate), 
@@ -8,69 +19,148 @@ LowPassFilter::LowPassFilter(float sampleRate)
       resonance(0.0f),  // Default resonance (no resonance)
       lfoFrequency(0.0f), // Default LFO frequency: 0 Hz (no modulation)
       lfoAmount(0.0f),    // Default LFO amount: 0 (no modulation)
-      lfoPhase(0.0f),     // Initial LFO phase: 0
+      lfoPhase(0),        // Initial LFO phase: 0
+      lfoStep(0),
       baseCutoff(20000.0f), // Base cutoff frequency
       x1(0.0f), 
       x2(0.0f), 
       y1(0.0f), 
-      y2(0.0f) {
+      y2(0.0f),
+      rampStart { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f },
+      rampStep { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f },
+      controlPosition(INTERVAL),
+      coefficientsStale(false) {
     updateCoefficients();
 }
 
+// Set the sample rate (in Hz) and recalculate coefficients
+void LowPassFilter::setSampleRate(float newSampleRate) {
+    sampleRate = newSampleRate;
+    updateLFOStep();
+    refreshCoefficients();
+}
+
 // Set a new cutoff frequency (in Hz)
+// Parameters are re-applied every block, so unchanged values return early
 void LowPassFilter::setCutoff(float newCutoff) {
-    std::lock_guard<std::mutex> lock(mutex); // Thread-safe update
+    if (newCutoff == baseCutoff) return;
     baseCutoff = newCutoff; // Save the base cutoff frequency
     updateCutoffWithLFO(); // Apply LFO modulation
 }
 
 // Set a new resonance (usually between 0.0 and 1.0)
 void LowPassFilter::setResonance(float newResonance) {
-    std::lock_guard<std::mutex> lock(mutex); // Thread-safe update
+    if (newResonance == resonance) return;
     resonance = newResonance;
-    updateCoefficients(); // Recalculate filter coefficients
+    refreshCoefficients(); // Recalculate filter coefficients
 }
 
 // Set LFO frequency for automatic cutoff variation
 void LowPassFilter::setAutoVariationFrequency(float frequency) {
-    std::lock_guard<std::mutex> lock(mutex);
+    if (frequency == lfoFrequency) return;
     lfoFrequency = frequency;
+    updateLFOStep();
     updateCutoffWithLFO();
 }
 
 // Set LFO amount for automatic cutoff variation
 void LowPassFilter::setAutoVariationAmount(float amount) {
-    std::lock_guard<std::mutex> lock(mutex);
+    if (amount == lfoAmount) return;
     lfoAmount = amount;
     updateCutoffWithLFO();
 }
 
 // Reset filter history (clear previous input/output samples)
 void LowPassFilter::reset() {
-    std::lock_guard<std::mutex> lock(mutex); // Thread-safe reset
     x1 = x2 = y1 = y2 = 0.0f;
-    lfoPhase = 0.0f; // Reset LFO phase
+    // The next ramp starts from the coefficients at the phase reached so far
+    if (coefficientsStale) applyLFO();
+    lfoPhase = 0; // Reset LFO phase
+    controlPosition = INTERVAL;
 }
 
 // Process a single input sample and return the filtered output
 float LowPassFilter::process(float input) {
-    std::lock_guard<std::mutex> lock(mutex); // Thread-safe processing
-    
-    // Update LFO phase and apply modulation if enabled
-    if (lfoFrequency >= 1.0f && lfoAmount > 0.0f) {
-        updateLFO();
+    processBlock(&input, 1);
+    return input;
+}
+
+// Filter a buffer in place, same result as process() on each sample
+// With the LFO on, the coefficients are updated at control rate and interpolated per sample
+void LowPassFilter::processBlock(float* samples, int count) {
+    float h1 = x1, h2 = x2, g1 = y1, g2 = y2;  // History kept in registers
+
+    if (!lfoActive()) {
+        for (int i = 0; i < count; i++) {
+            float input = samples[i];
+            // Apply the difference equation of the biquad filter
+            float output = a0 * input + a1 * h1 + a2 * h2 - b1 * g1 - b2 * g2;
+            h2 = h1;
+            h1 = input;
+            g2 = g1;
+            g1 = output;
+            samples[i] = output;
+        }
+    } else {
+        int i = 0;
+        while (i < count) {
+            if (controlPosition >= INTERVAL) {
+                controlTick();
+            }
+            int run = std::min(count - i, INTERVAL - controlPosition);
+            for (int end = i + run; i < end; i++) {
+                auto k = static_cast<float>(++controlPosition);
+                float c0 = rampStart[0] + rampStep[0] * k;
+                float c1 = rampStart[1] + rampStep[1] * k;
+                float c2 = rampStart[2] + rampStep[2] * k;
+                float d1 = rampStart[3] + rampStep[3] * k;
+                float d2 = rampStart[4] + rampStep[4] * k;
+                float input = samples[i];
+                float output = c0 * input + c1 * h1 + c2 * h2 - d1 * g1 - d2 * g2;
+                h2 = h1;
+                h1 = input;
+                g2 = g1;
+                g1 = output;
+                samples[i] = output;
+            }
+        }
     }
-    
-    // Apply the difference equation of the biquad filter
-    float output = a0 * input + a1 * x1 + a2 * x2 - b1 * y1 - b2 * y2;
 
-    // Shift history for next sample
-    x2 = x1;
-    x1 = input;
-    y2 = y1;
-    y1 = output;
+    x1 = h1;
+    x2 = h2;
+    y1 = g1;
+    y2 = g2;
+}
 
-    return output;
+// True once the history has decayed below audibility
+bool LowPassFilter::isSettled() const {
+    return std::fabs(x1) < SILENCE_THRESHOLD && std::fabs(x2) < SILENCE_THRESHOLD
+        && std::fabs(y1) < SILENCE_THRESHOLD && std::fabs(y2) < SILENCE_THRESHOLD;
+}
+
+// Stand-in for process() over 'frames' samples of silence once settled
+// The LFO lands on the same phase and coefficients as per-sample processing would
+void LowPassFilter::skipSilence(int frames) {
+    x1 = x2 = y1 = y2 = 0.0f;
+    if (!lfoActive()) return;
+    // Ticks fall on the same samples as when processing, but only move the phase:
+    // the coefficients are worked out once, at the first tick after rendering resumes.
+    // Only a tick whose interval the skip ends inside builds its ramp now, as the rest
+    // of that ramp is what processing picks up
+    while (frames > 0) {
+        if (controlPosition >= INTERVAL) {
+            if (frames < INTERVAL) {
+                controlTick();
+            } else {
+                lfoPhase += lfoStep * static_cast<uint32_t>(INTERVAL);
+                controlPosition = 0;
+                coefficientsStale = true;
+            }
+        }
+        int run = std::min(frames, INTERVAL - controlPosition);
+        controlPosition += run;
+        frames -= run;
+    }
 }
 
 // Recalculate filter coefficients based on cutoff and resonance
@@ -97,16 +187,45 @@ void LowPassFilter::updateCoefficients() {
     b2 = (1.0f - alpha) * norm;
 }
 
-// Update LFO phase and apply modulation to cutoff frequency
-void LowPassFilter::updateLFO() {
-    // Update LFO phase
-    lfoPhase += 2.0f * M_PI * lfoFrequency / sampleRate;
-    if (lfoPhase >= 2.0f * M_PI) {
-        lfoPhase -= 2.0f * M_PI;
+// Recalculate the coefficients after a parameter change, at the LFO phase reached
+// if skipSilence() has moved it on since they were last worked out
+void LowPassFilter::refreshCoefficients() {
+    if (coefficientsStale) {
+        applyLFO();
+    } else {
+        updateCoefficients();
     }
-    
+}
+
+// True while the LFO modulates the cutoff
+bool LowPassFilter::lfoActive() const {
+    return lfoFrequency >= 1.0f && lfoAmount > 0.0f;
+}
+
+// Control-rate LFO update: one sin plus one coefficient calculation per interval
+// instead of per sample, with a linear ramp in between so the sweep stays smooth
+void LowPassFilter::controlTick() {
+    // The new ramp starts where the last one was aimed
+    if (coefficientsStale) applyLFO();
+    const float start[5] = { a0, a1, a2, b1, b2 };
+
+    // Move the LFO to the end of the interval (unsigned wraparound is the cycle wrap)
+    lfoPhase += lfoStep * static_cast<uint32_t>(INTERVAL);
+    applyLFO();
+
+    const float end[5] = { a0, a1, a2, b1, b2 };
+    for (int c = 0; c < 5; c++) {
+        rampStart[c] = start[c];
+        rampStep[c] = (end[c] - start[c]) * (1.0f / INTERVAL);
+    }
+    controlPosition = 0;
+}
+
+// Apply modulation at the current LFO phase without advancing it
+void LowPassFilter::applyLFO() {
     // Calculate LFO modulation value (sine wave)
-    float lfoValue = sin(lfoPhase);
+    constexpr float PHASE_TO_RADIANS = static_cast<float>(SynthConstants::TWO_PI / SynthConstants::PHASE_CYCLE);
+    float lfoValue = std::sin(static_cast<float>(lfoPhase) * PHASE_TO_RADIANS);
     
     // Apply modulation to cutoff frequency
     // Amount of 1.0 gives ±5000 Hz variation around base frequency
@@ -118,16 +237,28 @@ void LowPassFilter::updateLFO() {
     
     // Update filter coefficients with new cutoff frequency
     updateCoefficients();
+    coefficientsStale = false;
 }
 
 // Update cutoff frequency with current LFO modulation
 void LowPassFilter::updateCutoffWithLFO() {
-    if (lfoFrequency >= 1.0f && lfoAmount > 0.0f) {
-        // Apply current LFO modulation
-        updateLFO();
+    if (lfoActive()) {
+        // Apply current LFO modulation (the phase only advances with processed samples,
+        // so the LFO rate does not depend on how often parameters are set)
+        // The ramp in progress keeps going; the next one starts from the new target
+        applyLFO();
     } else {
         // No LFO modulation, use base cutoff frequency
         cutoff = baseCutoff;
         updateCoefficients();
+        coefficientsStale = false;
+        // When the LFO starts again, its first sample begins a fresh ramp
+        controlPosition = INTERVAL;
     }
 }
+
+// Recompute the LFO phase increment from its frequency and the sample rate
+void LowPassFilter::updateLFOStep() {
+    lfoStep = static_cast<uint32_t>(static_cast<int64_t>(std::llround(
+        static_cast<double>(lfoFrequency) / sampleRate * SynthConstants::PHASE_CYCLE)));
+}
@@ -0,0 +1,329 @@
+#include "include/LadderFilter.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef AUDIOSYNTH_X86_KERNELS
+#include <emmintrin.h>
+#endif
+
+namespace LadderKernels {
+
+// Reference kernel, lane by lane
+void processScalar(State& state, const Coefficients* coefficients, const Settings& settings,
+                   float* frames, int count, int lanes) {
+    const float* positions = STEP_POSITIONS[settings.oversampling / 2];
+    const float average = 1.0f / static_cast<float>(settings.oversampling);
+    for (int l = 0; l < lanes; l++) {
+        float s0 = state.stage[0][l], s1 = state.stage[1][l], s2 = state.stage[2][l], s3 = state.stage[3][l];
+        float previous = state.previous[l];
+        for (int i = 0; i < count; i++) {
+            const Coefficients& c = coefficients[i];
+            float x = frames[i * LANES + l];
+            float sum = 0.0f;
+            for (int step = 0; step < settings.oversampling; step++) {
+                float in = settings.drive * (previous + (x - previous) * positions[step]);
+                // Ladder input with the feedback loop solved, then saturated
+                float sigma = (c.weights[0] * s0 + c.weights[1] * s1) + (c.weights[2] * s2 + c.oneMinusG * s3);
+                float u = saturate((in - settings.feedback * sigma) * c.solve);
+                // Four trapezoidal one-pole stages: y = G u + (1 - G) s, then s = 2 y - s
+                float y = c.g * u + c.oneMinusG * s0; s0 = (y + y) - s0; u = y;
+                y = c.g * u + c.oneMinusG * s1; s1 = (y + y) - s1; u = y;
+                y = c.g * u + c.oneMinusG * s2; s2 = (y + y) - s2; u = y;
+                y = c.g * u + c.oneMinusG * s3; s3 = (y + y) - s3; u = y;
+                sum = sum + u;
+            }
+            frames[i * LANES + l] = sum * average;
+            previous = x;
+        }
+        state.stage[0][l] = s0;
+        state.stage[1][l] = s1;
+        state.stage[2][l] = s2;
+        state.stage[3][l] = s3;
+        state.previous[l] = previous;
+    }
+}
+
+#ifdef AUDIOSYNTH_X86_KERNELS
+
+// SSE2 (baseline on x86-64): one group of 4 instances per register
+void processSSE2(State& state, const Coefficients* coefficients, const Settings& settings,
+                 float* frames, int count, int lanes) {
+    const float* positions = STEP_POSITIONS[settings.oversampling / 2];
+    const __m128 vAverage = _mm_set1_ps(1.0f / static_cast<float>(settings.oversampling));
+    const __m128 vDrive = _mm_set1_ps(settings.drive);
+    const __m128 vFeedback = _mm_set1_ps(settings.feedback);
+    const __m128 v27 = _mm_set1_ps(27.0f);
+    const __m128 v9 = _mm_set1_ps(9.0f);
+    const __m128 vOne = _mm_set1_ps(1.0f);
+    const __m128 vMinusOne = _mm_set1_ps(-1.0f);
+
+    for (int base = 0; base < lanes; base += LANE_GROUP) {
+        __m128 s0 = _mm_load_ps(state.stage[0] + base);
+        __m128 s1 = _mm_load_ps(state.stage[1] + base);
+        __m128 s2 = _mm_load_ps(state.stage[2] + base);
+        __m128 s3 = _mm_load_ps(state.stage[3] + base);
+        __m128 previous = _mm_load_ps(state.previous + base);
+        for (int i = 0; i < count; i++) {
+            const Coefficients& c = coefficients[i];
+            const __m128 g = _mm_set1_ps(c.g);
+            const __m128 oneMinusG = _mm_set1_ps(c.oneMinusG);
+            const __m128 w0 = _mm_set1_ps(c.weights[0]);
+            const __m128 w1 = _mm_set1_ps(c.weights[1]);
+            const __m128 w2 = _mm_set1_ps(c.weights[2]);
+            const __m128 solve = _mm_set1_ps(c.solve);
+            __m128 x = _mm_load_ps(frames + i * LANES + base);
+            __m128 sum = _mm_setzero_ps();
+            for (int step = 0; step < settings.oversampling; step++) {
+                __m128 in = _mm_mul_ps(vDrive, _mm_add_ps(previous, _mm_mul_ps(_mm_sub_ps(x, previous),
+                                                                               _mm_set1_ps(positions[step]))));
+                __m128 sigma = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w0, s0), _mm_mul_ps(w1, s1)),
+                                          _mm_add_ps(_mm_mul_ps(w2, s2), _mm_mul_ps(oneMinusG, s3)));
+                __m128 u = _mm_mul_ps(_mm_sub_ps(in, _mm_mul_ps(vFeedback, sigma)), solve);
+                __m128 u2 = _mm_mul_ps(u, u);
+                u = _mm_div_ps(_mm_mul_ps(u, _mm_add_ps(v27, u2)), _mm_add_ps(v27, _mm_mul_ps(v9, u2)));
+                u = _mm_max_ps(_mm_min_ps(u, vOne), vMinusOne);
+                __m128 y = _mm_add_ps(_mm_mul_ps(g, u), _mm_mul_ps(oneMinusG, s0)); s0 = _mm_sub_ps(_mm_add_ps(y, y), s0);
+                y = _mm_add_ps(_mm_mul_ps(g, y), _mm_mul_ps(oneMinusG, s1)); s1 = _mm_sub_ps(_mm_add_ps(y, y), s1);
+                y = _mm_add_ps(_mm_mul_ps(g, y), _mm_mul_ps(oneMinusG, s2)); s2 = _mm_sub_ps(_mm_add_ps(y, y), s2);
+                y = _mm_add_ps(_mm_mul_ps(g, y), _mm_mul_ps(oneMinusG, s3)); s3 = _mm_sub_ps(_mm_add_ps(y, y), s3);
+                sum = _mm_add_ps(sum, y);
+            }
+            _mm_store_ps(frames + i * LANES + base, _mm_mul_ps(sum, vAverage));
+            previous = x;
+        }
+        _mm_store_ps(state.stage[0] + base, s0);
+        _mm_store_ps(state.stage[1] + base, s1);
+        _mm_store_ps(state.stage[2] + base, s2);
+        _mm_store_ps(state.stage[3] + base, s3);
+        _mm_store_ps(state.previous + base, previous);
+    }
+}
+
+#endif // AUDIOSYNTH_X86_KERNELS
+
+Kernel kernel(OscillatorKernels::Isa isa) {
+    switch (isa) {
+#ifdef AUDIOSYNTH_X86_KERNELS
+        case OscillatorKernels::Isa::SSE2: return processSSE2;
+        case OscillatorKernels::Isa::AVX2:
+        case OscillatorKernels::Isa::AVX512: return processAVX2;
+#endif
+        default: return processScalar;
+    }
+}
+
+} // namespace LadderKernels
+
+namespace {
+
+// Highest warped cutoff, pi * 0.49: just below the Nyquist frequency of the oversampled rate
+constexpr double MAX_WARP = M_PI * 0.49;
+
+// Instance state level below which the output is treated as silence (about -140 dB)
+constexpr float SILENCE_THRESHOLD = 1.0e-7f;
+
+constexpr int INTERVAL = SynthConstants::CONTROL_INTERVAL;
+constexpr int CHUNK = SynthConstants::RENDER_BLOCK_SIZE;
+
+} // namespace
+
+// Constructor initializing sample rate and default parameters
+LadderFilter::LadderFilter(float sampleRate)
+    : sampleRate(sampleRate),
+      cutoff(1000.0f),
+      resonance(0.0f),
+      drive(1.0f),
+      oversampling(2),
+      lfoFrequency(0.0f),
+      lfoAmount(0.0f),
+      lfoPhase(0),
+      lfoStep(0),
+      gain(0.0f),
+      rampStart(0.0f),
+      rampStep(0.0f),
+      controlPosition(INTERVAL),
+      kernel(LadderKernels::kernel(OscillatorKernels::detectIsa())),
+      state {},
+      frames {},
+      coefficients {} {
+    updateCoefficients();
+}
+
+// Set the sample rate (in Hz) and recalculate coefficients
+void LadderFilter::setSampleRate(float newSampleRate) {
+    sampleRate = newSampleRate;
+    updateLFOStep();
+    updateCoefficients();
+}
+
+// Set a new cutoff frequency (in Hz)
+// Parameters are re-applied every block, so unchanged values return early
+void LadderFilter::setCutoff(float newCutoff) {
+    if (newCutoff == cutoff) return;
+    cutoff = newCutoff;
+    updateCoefficients();
+}
+
+// Set a new resonance (0.0 to 0.99; self-oscillation starts near 1.0)
+void LadderFilter::setResonance(float newResonance) {
+    resonance = newResonance;
+}
+
+// Set the input gain into the saturation
+void LadderFilter::setDrive(float newDrive) {
+    drive = newDrive;
+}
+
+// Set the oversampling factor: 1, 2 or 4
+void LadderFilter::setOversampling(int factor) {
+    factor = factor >= 4 ? 4 : (factor >= 2 ? 2 : 1);
+    if (factor == oversampling) return;
+    oversampling = factor;
+    updateCoefficients();
+}
+
+// Set LFO frequency for automatic cutoff variation
+void LadderFilter::setAutoVariationFrequency(float frequency) {
+    if (frequency == lfoFrequency) return;
+    lfoFrequency = frequency;
+    updateLFOStep();
+    updateCoefficients();
+}
+
+// Set LFO amount for automatic cutoff variation
+void LadderFilter::setAutoVariationAmount(float amount) {
+    if (amount == lfoAmount) return;
+    lfoAmount = amount;
+    updateCoefficients();
+}
+
+// Reset every instance
+void LadderFilter::reset() {
+    state = {};
+    lfoPhase = 0; // Reset LFO phase
+    controlPosition = INTERVAL;
+}
+
+// Filter 'lanes' channel buffers in place, instance l on channels[l]
+// The block goes through in sub-blocks: interleave, work out the per-sample
+// coefficients once for all lanes, run the kernel, de-interleave
+void LadderFilter::processBlock(float* const* channels, int lanes, int count) {
+    const int groupLanes = (lanes + LadderKernels::LANE_GROUP - 1) / LadderKernels::LANE_GROUP
+                           * LadderKernels::LANE_GROUP;
+    const float feedback = 4.0f * resonance;
+    const LadderKernels::Settings settings { feedback, drive, oversampling };
+
+    for (int offset = 0; offset < count; offset += CHUNK) {
+        int run = std::min(count - offset, CHUNK);
+
+        for (int i = 0; i < run; i++) {
+            float* frame = frames + i * LANES;
+            for (int l = 0; l < lanes; l++) {
+                frame[l] = channels[l][offset + i];
+            }
+            std::fill(frame + lanes, frame + groupLanes, 0.0f);
+        }
+
+        for (int i = 0; i < run; i++) {
+            float g = gain;
+            if (lfoActive()) {
+                if (controlPosition >= INTERVAL) {
+                    controlTick();
+                }
+                g = rampStart + rampStep * static_cast<float>(++controlPosition);
+            }
+            float oneMinusG = 1.0f - g;
+            float g2 = g * g;
+            coefficients[i] = { g, oneMinusG, { g2 * g * oneMinusG, g2 * oneMinusG, g * oneMinusG },
+                                1.0f / (1.0f + feedback * (g2 * g2)) };
+        }
+
+        kernel(state, coefficients, settings, frames, run, groupLanes);
+
+        for (int i = 0; i < run; i++) {
+            for (int l = 0; l < lanes; l++) {
+                channels[l][offset + i] = frames[i * LANES + l];
+            }
+        }
+    }
+}
+
+// Copy the state of one instance to another
+void LadderFilter::copyLane(int from, int to) {
+    for (auto& stage : state.stage) {
+        stage[to] = stage[from];
+    }
+    state.previous[to] = state.previous[from];
+}
+
+// True once every instance has decayed below audibility
+bool LadderFilter::isSettled() const {
+    for (const auto& stage : state.stage) {
+        for (float s : stage) {
+            if (std::fabs(s) >= SILENCE_THRESHOLD) return false;
+        }
+    }
+    for (float p : state.previous) {
+        if (std::fabs(p) >= SILENCE_THRESHOLD) return false;
+    }
+    return true;
+}
+
+// Stand-in for processBlock() over 'frames' samples of silence once settled
+// Ticks fall on the same samples as when processing, only the per-sample work is skipped
+void LadderFilter::skipSilence(int frames) {
+    state = {};
+    if (!lfoActive()) return;
+    while (frames > 0) {
+        if (controlPosition >= INTERVAL) {
+            controlTick();
+        }
+        int run = std::min(frames, INTERVAL - controlPosition);
+        controlPosition += run;
+        frames -= run;
+    }
+}
+
+// Recalculate the one-pole gain for the current cutoff
+// With the LFO on, the ramp in progress keeps going and the next one starts from here
+void LadderFilter::updateCoefficients() {
+    if (lfoActive()) {
+        // Same modulation as LowPassFilter: +-5000 Hz at amount 1.0, clamped to 20 Hz - 20 kHz
+        constexpr float PHASE_TO_RADIANS = static_cast<float>(SynthConstants::TWO_PI / SynthConstants::PHASE_CYCLE);
+        float lfoValue = std::sin(static_cast<float>(lfoPhase) * PHASE_TO_RADIANS);
+        gain = stageGain(std::clamp(cutoff + lfoValue * lfoAmount * 5000.0f, 20.0f, 20000.0f));
+    } else {
+        gain = stageGain(cutoff);
+        // When the LFO starts again, its first sample begins a fresh ramp
+        controlPosition = INTERVAL;
+    }
+}
+
+// True while the LFO modulates the cutoff
+bool LadderFilter::lfoActive() const {
+    return lfoFrequency >= 1.0f && lfoAmount > 0.0f;
+}
+
+// Control-rate LFO update: one sin and one tan per interval, with a linear ramp in between
+void LadderFilter::controlTick() {
+    float start = gain;
+    // Move the LFO to the end of the interval (unsigned wraparound is the cycle wrap)
+    lfoPhase += lfoStep * static_cast<uint32_t>(INTERVAL);
+    updateCoefficients();
+    rampStart = start;
+    rampStep = (gain - start) * (1.0f / INTERVAL);
+    controlPosition = 0;
+}
+
+// Recompute the LFO phase increment from its frequency and the sample rate
+void LadderFilter::updateLFOStep() {
+    lfoStep = static_cast<uint32_t>(static_cast<int64_t>(std::llround(
+        static_cast<double>(lfoFrequency) / sampleRate * SynthConstants::PHASE_CYCLE)));
+}
+
+// One-pole gain G = g / (1 + g) for a cutoff at the oversampled rate, g pre-warped
+float LadderFilter::stageGain(float frequency) const {
+    double warp = std::clamp(M_PI * frequency / (static_cast<double>(sampleRate) * oversampling), 0.0, MAX_WARP);
+    double g = std::tan(warp);
+    return static_cast<float>(g / (1.0 + g));
+}
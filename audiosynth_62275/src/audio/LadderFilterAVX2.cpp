@@ -0,0 +1,69 @@
+// AVX2 ladder kernel: built with AVX2 enabled, only called when detectIsa() reports it
+#include "include/LadderFilter.h"
+
+#ifdef AUDIOSYNTH_X86_KERNELS
+#include <immintrin.h>
+
+namespace LadderKernels {
+
+// The whole bank of 8 instances in one register
+void processAVX2(State& state, const Coefficients* coefficients, const Settings& settings,
+                 float* frames, int count, int lanes) {
+    // A bank is one register of 8 lanes: either it is full, or only its first SSE2 group is in use
+    if (lanes < LANES) {
+        processSSE2(state, coefficients, settings, frames, count, lanes);
+        return;
+    }
+
+    const float* positions = STEP_POSITIONS[settings.oversampling / 2];
+    const __m256 vAverage = _mm256_set1_ps(1.0f / static_cast<float>(settings.oversampling));
+    const __m256 vDrive = _mm256_set1_ps(settings.drive);
+    const __m256 vFeedback = _mm256_set1_ps(settings.feedback);
+    const __m256 v27 = _mm256_set1_ps(27.0f);
+    const __m256 v9 = _mm256_set1_ps(9.0f);
+    const __m256 vOne = _mm256_set1_ps(1.0f);
+    const __m256 vMinusOne = _mm256_set1_ps(-1.0f);
+
+    __m256 s0 = _mm256_load_ps(state.stage[0]);
+    __m256 s1 = _mm256_load_ps(state.stage[1]);
+    __m256 s2 = _mm256_load_ps(state.stage[2]);
+    __m256 s3 = _mm256_load_ps(state.stage[3]);
+    __m256 previous = _mm256_load_ps(state.previous);
+    for (int i = 0; i < count; i++) {
+        const Coefficients& c = coefficients[i];
+        const __m256 g = _mm256_set1_ps(c.g);
+        const __m256 oneMinusG = _mm256_set1_ps(c.oneMinusG);
+        const __m256 w0 = _mm256_set1_ps(c.weights[0]);
+        const __m256 w1 = _mm256_set1_ps(c.weights[1]);
+        const __m256 w2 = _mm256_set1_ps(c.weights[2]);
+        const __m256 solve = _mm256_set1_ps(c.solve);
+        __m256 x = _mm256_load_ps(frames + i * LANES);
+        __m256 sum = _mm256_setzero_ps();
+        for (int step = 0; step < settings.oversampling; step++) {
+            __m256 in = _mm256_mul_ps(vDrive, _mm256_add_ps(previous, _mm256_mul_ps(_mm256_sub_ps(x, previous),
+                                                                                    _mm256_set1_ps(positions[step]))));
+            __m256 sigma = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(w0, s0), _mm256_mul_ps(w1, s1)),
+                                         _mm256_add_ps(_mm256_mul_ps(w2, s2), _mm256_mul_ps(oneMinusG, s3)));
+            __m256 u = _mm256_mul_ps(_mm256_sub_ps(in, _mm256_mul_ps(vFeedback, sigma)), solve);
+            __m256 u2 = _mm256_mul_ps(u, u);
+            u = _mm256_div_ps(_mm256_mul_ps(u, _mm256_add_ps(v27, u2)), _mm256_add_ps(v27, _mm256_mul_ps(v9, u2)));
+            u = _mm256_max_ps(_mm256_min_ps(u, vOne), vMinusOne);
+            __m256 y = _mm256_add_ps(_mm256_mul_ps(g, u), _mm256_mul_ps(oneMinusG, s0)); s0 = _mm256_sub_ps(_mm256_add_ps(y, y), s0);
+            y = _mm256_add_ps(_mm256_mul_ps(g, y), _mm256_mul_ps(oneMinusG, s1)); s1 = _mm256_sub_ps(_mm256_add_ps(y, y), s1);
+            y = _mm256_add_ps(_mm256_mul_ps(g, y), _mm256_mul_ps(oneMinusG, s2)); s2 = _mm256_sub_ps(_mm256_add_ps(y, y), s2);
+            y = _mm256_add_ps(_mm256_mul_ps(g, y), _mm256_mul_ps(oneMinusG, s3)); s3 = _mm256_sub_ps(_mm256_add_ps(y, y), s3);
+            sum = _mm256_add_ps(sum, y);
+        }
+        _mm256_store_ps(frames + i * LANES, _mm256_mul_ps(sum, vAverage));
+        previous = x;
+    }
+    _mm256_store_ps(state.stage[0], s0);
+    _mm256_store_ps(state.stage[1], s1);
+    _mm256_store_ps(state.stage[2], s2);
+    _mm256_store_ps(state.stage[3], s3);
+    _mm256_store_ps(state.previous, previous);
+}
+
+} // namespace LadderKernels
+
+#endif // AUDIOSYNTH_X86_KERNELS
@@ -0,0 +1,95 @@
+#include "include/NoiseGenerator.h"
+#include "include/SynthConstants.h"
+#include <algorithm>
+
+namespace {
+
+// Output gains that bring pink and brown noise to about the RMS level of white noise
+constexpr float PINK_GAIN = 0.33f;
+constexpr float BROWN_LEAK = 0.995f;   // Integrator pole, about 35 Hz corner at 44.1 kHz
+constexpr float BROWN_GAIN = 20.0f;    // sqrt((1 + leak) / (1 - leak))
+
+} // namespace
+
+// Constructor: seeded with SynthConstants::DEFAULT_NOISE_SEED
+NoiseGenerator::NoiseGenerator() {
+    setSeed(SynthConstants::DEFAULT_NOISE_SEED);
+}
+
+// Restart every stream from a seed (same seed = same noise)
+void NoiseGenerator::setSeed(uint32_t seed) {
+    for (int lane = 0; lane < LANES; lane++) {
+        // Scramble seed and lane so nearby seeds give unrelated streams; xorshift needs a non-zero state
+        uint32_t x = (seed * LANES + static_cast<uint32_t>(lane)) * 0x9E3779B9u;
+        x ^= x >> 16;
+        x *= 0x85EBCA6Bu;
+        x ^= x >> 13;
+        state[lane] = x != 0 ? x : 0x6D2B79F5u;
+    }
+    pendingIndex = LANES;
+    pink[0] = pink[1] = pink[2] = 0.0f;
+    brown = 0.0f;
+}
+
+// Advance every stream once and write LANES white samples in -1 to 1
+void NoiseGenerator::nextWhite(float* out) {
+    for (int lane = 0; lane < LANES; lane++) {
+        uint32_t x = state[lane];
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        state[lane] = x;
+        out[lane] = static_cast<float>(static_cast<int32_t>(x >> 8)) * (2.0f / 16777216.0f) - 1.0f;
+    }
+}
+
+// Fill 'out' with white noise, continuing the interleaved sequence
+void NoiseGenerator::white(float* out, int count) {
+    int i = 0;
+    // Leftovers from the previous call come first
+    while (pendingIndex < LANES && i < count) {
+        out[i++] = pending[pendingIndex++];
+    }
+    // Whole groups straight into the output
+    for (; i + LANES <= count; i += LANES) {
+        nextWhite(out + i);
+    }
+    // Partial group: keep the rest for the next call
+    if (i < count) {
+        nextWhite(pending);
+        pendingIndex = 0;
+        while (i < count) {
+            out[i++] = pending[pendingIndex++];
+        }
+    }
+}
+
+// Render 'count' samples of the given colour (pink and brown at white's RMS level)
+void NoiseGenerator::process(Color color, float amplitude, float* out, int count) {
+    white(out, count);
+
+    switch (color) {
+        case Color::White:
+            for (int i = 0; i < count; i++) {
+                out[i] *= amplitude;
+            }
+            break;
+        case Color::Pink:
+            // Three one-pole lowpasses in parallel approximate a 1/f slope across the audio band
+            for (int i = 0; i < count; i++) {
+                float w = out[i];
+                pink[0] = 0.99765f * pink[0] + w * 0.0990460f;
+                pink[1] = 0.96300f * pink[1] + w * 0.2965164f;
+                pink[2] = 0.57000f * pink[2] + w * 1.0526913f;
+                out[i] = (pink[0] + pink[1] + pink[2] + w * 0.1848f) * (PINK_GAIN * amplitude);
+            }
+            break;
+        case Color::Brown:
+            // Leaky integrator: 1/f^2 above its corner, no DC wander
+            for (int i = 0; i < count; i++) {
+                brown = BROWN_LEAK * brown + (1.0f - BROWN_LEAK) * out[i];
+                out[i] = brown * (BROWN_GAIN * amplitude);
+            }
+            break;
+    }
+}
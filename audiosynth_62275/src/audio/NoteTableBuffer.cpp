@@ -0,0 +1,27 @@
+#include "include/NoteTableBuffer.h"
+
+// Constructor: nothing published yet
+NoteTableBuffer::NoteTableBuffer()
+    : slots {},
+      shared(1),
+      writeIndex(0),
+      readIndex(2) {}
+
+// Writer side: publish the note table of a tuning
+void NoteTableBuffer::publish(const Tuning& tuning) {
+    slots[writeIndex] = tuning.noteTable();
+    // Hand the filled slot over and take back whichever slot was shared
+    uint8_t previous = shared.exchange(writeIndex | FRESH_BIT, std::memory_order_acq_rel);
+    writeIndex = previous & INDEX_MASK;
+}
+
+// Reader side: the table published since the last call, or null if there is none
+const Tuning::NoteTable* NoteTableBuffer::take() {
+    if (!(shared.load(std::memory_order_relaxed) & FRESH_BIT)) {
+        return nullptr;
+    }
+    // Take the fresh slot and leave our old one for the writer to reuse
+    uint8_t previous = shared.exchange(readIndex, std::memory_order_acq_rel);
+    readIndex = previous & INDEX_MASK;
+    return &slots[readIndex];
+}
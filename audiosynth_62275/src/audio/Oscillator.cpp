@@ -1,89 +1,205 @@
 #include "include/Oscillator.h"
+#include <algorithm>
 #include <cmath>
-#include <cstdlib>
+
+namespace {
+
+// Bank shape serving each table-based waveform
+Wavetable::Shape tableShape(Oscillator::Waveform wf) {
+    switch (wf) {
+        case Oscillator::Waveform::Saw: return Wavetable::Shape::Saw;
+        case Oscillator::Waveform::Square: return Wavetable::Shape::Square;
+        case Oscillator::Waveform::Pulse: return Wavetable::Shape::Pulse;
+        default: return Wavetable::Shape::Triangle;
+    }
+}
+
+// Start the stacked copies at scattered phases (golden-ratio spacing) so a stack
+// does not begin as one loud in-phase peak
+constexpr uint32_t UNISON_PHASE_SPACING = 0x9E3779B9u;
+
+} // namespace
 
 // Constructor initializes oscillator parameters
-Oscillator::Oscillator() : frequency(440.0), phase(0.0), waveform(Waveform::Triangle), isEnabled(true), frequencyOffset(0.0) {
-    std::lock_guard<std::mutex> lock(mutex);
+Oscillator::Oscillator() : phaseIncrement(440.0 / SynthConstants::DEFAULT_SAMPLE_RATE * SynthConstants::PHASE_CYCLE),
+                           unisonCount(1), unisonDetune(0.0f), unisonSpread(0.0f),
+                           waveform(Waveform::Triangle), isEnabled(true), frequencyOffset(0.0), sampleRate(SynthConstants::DEFAULT_SAMPLE_RATE),
+                           table(nullptr),
+                           tableKernel(OscillatorKernels::tableKernel(OscillatorKernels::detectIsa())),
+                           unisonKernel(OscillatorKernels::unisonKernel(OscillatorKernels::detectIsa())) {
+    for (int k = 0; k < SynthConstants::MAX_UNISON; k++) {
+        phases[k] = UNISON_PHASE_SPACING * static_cast<uint32_t>(k);
+    }
+    // First construction builds the shared wavetable bank, off the audio thread
+    updateStepRatios();
     updatePhaseStep();
+    updateUnisonGains();
 }
 
 // Set the oscillator frequency in Hz
 void Oscillator::setFrequency(double freq) { 
-    std::lock_guard<std::mutex> lock(mutex);
-    frequency = freq; 
+    setPhaseIncrement(freq / sampleRate * SynthConstants::PHASE_CYCLE);
+}
+
+// Set the pitch as a phase increment per sample (2^32 = one cycle)
+void Oscillator::setPhaseIncrement(double increment) {
+    phaseIncrement = increment;
     updatePhaseStep();
 }
 
 // Set the waveform type
 void Oscillator::setWaveform(Waveform wf) { 
-    std::lock_guard<std::mutex> lock(mutex);
     waveform = wf; 
+    selectTable();
 }
 
 // Enable or disable the oscillator
 void Oscillator::setEnabled(bool enabled) { 
-    std::lock_guard<std::mutex> lock(mutex);
     isEnabled = enabled; 
 }
 
 // Get the current enabled state
 bool Oscillator::getEnabled() const { 
-    std::lock_guard<std::mutex> lock(mutex);
     return isEnabled; 
 }
 
 // Set frequency offset in semitones
 void Oscillator::setFrequencyOffset(float offset) {
-    std::lock_guard<std::mutex> lock(mutex);
     frequencyOffset = offset;
+    updateStepRatios();
     updatePhaseStep();
 }
 
-// Process a buffer of samples
-void Oscillator::processBuffer(float* buffer, int bufferSize) {
-    std::lock_guard<std::mutex> lock(mutex);
-    for(int i = 0; i < bufferSize; i++) {
-        buffer[i] = generateSample();
-    }
+// Set the sample rate used to compute the phase step
+// The current pitch is kept: its increment is rescaled to the new rate
+void Oscillator::setSampleRate(double sr) {
+    phaseIncrement = phaseIncrement * sampleRate / sr;
+    sampleRate = sr;
+    updatePhaseStep();
 }
 
-// Phase control methods
-double Oscillator::getPhase() const { 
-    std::lock_guard<std::mutex> lock(mutex);
-    return phase; 
+// Seed this oscillator's own noise generator (same seed = same noise)
+void Oscillator::setSeed(uint32_t seed) {
+    noise.setSeed(seed);
 }
 
-void Oscillator::setPhase(double newPhase) { 
-    std::lock_guard<std::mutex> lock(mutex);
-    phase = newPhase; 
+// Stack 1 to MAX_UNISON copies of the waveform
+void Oscillator::setUnison(int count) {
+    unisonCount = std::clamp(count, 1, SynthConstants::MAX_UNISON);
+    updateStepRatios();
+    updatePhaseStep();
+    updateUnisonGains();
+}
+
+// Total detune across the stack in cents
+void Oscillator::setUnisonDetune(float cents) {
+    unisonDetune = std::max(0.0f, cents);
+    updateStepRatios();
+    updatePhaseStep();
 }
 
-// Generate a single sample based on current waveform
-float Oscillator::generateSample() {
-    if (!isEnabled) return 0.0f;
-    
-    float sample = 0.0f;
+// Stereo width of the stack, 0 (centre) to 1 (copies panned hard left to hard right)
+void Oscillator::setUnisonSpread(float spread) {
+    unisonSpread = std::clamp(spread, 0.0f, 1.0f);
+    updateUnisonGains();
+}
+
+// True when the stereo processBuffer gives different left and right channels
+bool Oscillator::isStereo() const {
+    if (!isEnabled || unisonCount < 2 || unisonSpread <= 0.0f) return false;
+    return waveform != Waveform::Noise && waveform != Waveform::PinkNoise && waveform != Waveform::BrownNoise;
+}
+
+// Process a buffer of samples with the SIMD kernel picked for this CPU
+// Waveform and enabled state are checked once per buffer, not per sample
+void Oscillator::processBuffer(float* buffer, int bufferSize, const uint32_t* phaseModulation) {
+    if (!isEnabled) {
+        std::fill(buffer, buffer + bufferSize, 0.0f);
+        return;
+    }
+    if (processNoise(buffer, bufferSize)) return;
+    // Band-limited mip-map level picked for the current pitch
+    if (unisonCount == 1) {
+        phases[0] = tableKernel(table, phases[0], steps[0], phaseModulation, SynthConstants::BASE_AMPLITUDE, buffer, bufferSize);
+    } else {
+        unisonKernel(table, phases, steps, phaseModulation, gainsCentre, gainsCentre, unisonCount, buffer, nullptr, bufferSize);
+    }
+}
+
+// Same, with the unison stack panned across left and right
+// Sources without stereo content render once and are copied to the right channel
+void Oscillator::processBuffer(float* left, float* right, int bufferSize, const uint32_t* phaseModulation) {
+    if (!isStereo()) {
+        processBuffer(left, bufferSize, phaseModulation);
+        std::copy(left, left + bufferSize, right);
+        return;
+    }
+    unisonKernel(table, phases, steps, phaseModulation, gainsLeft, gainsRight, unisonCount, left, right, bufferSize);
+}
+
+// Render a buffer of noise; false for table waveforms
+bool Oscillator::processNoise(float* buffer, int bufferSize) {
     switch (waveform) {
-        case Waveform::Triangle:
-            sample = SynthConstants::BASE_AMPLITUDE * static_cast<float>(std::asin(std::sin(phase)) * (2.0 / M_PI));
-            phase += phaseStep;
-            if (phase >= SynthConstants::TWO_PI) phase -= SynthConstants::TWO_PI;
-            break;
         case Waveform::Noise:
-            sample = SynthConstants::BASE_AMPLITUDE * (static_cast<float>(rand()) / RAND_MAX * 2.0f - 1.0f);
-            break;
-        case Waveform::Saw:
-            sample = SynthConstants::BASE_AMPLITUDE * static_cast<float>((phase / M_PI) - 1.0);
-            phase += phaseStep;
-            if (phase >= SynthConstants::TWO_PI) phase -= SynthConstants::TWO_PI;
-            break;
+            noise.process(NoiseGenerator::Color::White, SynthConstants::BASE_AMPLITUDE, buffer, bufferSize);
+            return true;
+        case Waveform::PinkNoise:
+            noise.process(NoiseGenerator::Color::Pink, SynthConstants::BASE_AMPLITUDE, buffer, bufferSize);
+            return true;
+        case Waveform::BrownNoise:
+            noise.process(NoiseGenerator::Color::Brown, SynthConstants::BASE_AMPLITUDE, buffer, bufferSize);
+            return true;
+        default:
+            return false;
     }
-    return sample;
 }
 
-// Update phase step based on current frequency
+// Phase control methods (radians, 0.0 to 2π)
+double Oscillator::getPhase() const { 
+    return phases[0] * (SynthConstants::TWO_PI / SynthConstants::PHASE_CYCLE); 
+}
+
+void Oscillator::setPhase(double newPhase) { 
+    double cycles = newPhase / SynthConstants::TWO_PI;
+    phases[0] = static_cast<uint32_t>(static_cast<uint64_t>((cycles - std::floor(cycles)) * SynthConstants::PHASE_CYCLE)); 
+}
+
+// Update phase step based on the current pitch
+// Runs on every note-on: one multiply per copy, the ratios are computed ahead of time
 void Oscillator::updatePhaseStep() {
-    double effectiveFrequency = frequency + frequencyOffset;
-    phaseStep = SynthConstants::TWO_PI * effectiveFrequency / SynthConstants::SAMPLE_RATE;
+    for (int k = 0; k < unisonCount; k++) {
+        // Rounded once here; the accumulator itself never loses precision, so pitch cannot drift
+        steps[k] = static_cast<uint32_t>(static_cast<int64_t>(std::llround(phaseIncrement * stepRatios[k])));
+    }
+    selectTable();
+}
+
+// Recompute the pitch ratio of each unison copy (offset and detune)
+// The offset is in semitones; copies are spread evenly from -detune/2 to +detune/2 cents
+void Oscillator::updateStepRatios() {
+    double offsetRatio = std::exp2(frequencyOffset / 12.0);
+    for (int k = 0; k < unisonCount; k++) {
+        double position = unisonCount > 1 ? 2.0 * k / (unisonCount - 1) - 1.0 : 0.0;
+        stepRatios[k] = offsetRatio * std::exp2(position * unisonDetune / 2400.0);
+    }
+}
+
+// Recompute the per-copy gains of the unison stack
+// Equal-power pan law, scaled by 1/sqrt(count) so the stack keeps the loudness of one copy
+void Oscillator::updateUnisonGains() {
+    double stackGain = SynthConstants::BASE_AMPLITUDE / std::sqrt(static_cast<double>(unisonCount));
+    for (int k = 0; k < unisonCount; k++) {
+        double position = unisonCount > 1 ? 2.0 * k / (unisonCount - 1) - 1.0 : 0.0;
+        double pan = position * unisonSpread;   // -1 = left, +1 = right
+        gainsLeft[k] = static_cast<float>(stackGain * std::sqrt(2.0) * std::cos((pan + 1.0) * M_PI / 4.0));
+        gainsRight[k] = static_cast<float>(stackGain * std::sqrt(2.0) * std::cos((1.0 - pan) * M_PI / 4.0));
+        gainsCentre[k] = static_cast<float>(stackGain);
+    }
+}
+
+// Pick the wavetable level for the current waveform and pitch
+// A unison stack shares one level, chosen for its highest copy so none of them alias
+void Oscillator::selectTable() {
+    uint32_t highestStep = *std::max_element(steps, steps + unisonCount);
+    table = Wavetable::instance().select(tableShape(waveform), highestStep / SynthConstants::PHASE_CYCLE);
 }
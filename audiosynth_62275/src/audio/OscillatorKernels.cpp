@@ -0,0 +1,184 @@
+#include "include/OscillatorKernels.h"
+
+#ifdef AUDIOSYNTH_X86_KERNELS
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace OscillatorKernels {
+
+// Reference kernel, also used for block tails by the SIMD kernels
+uint32_t renderTableScalar(const float* table, uint32_t phase, uint32_t step, const uint32_t* modulation,
+                           float amplitude, float* out, int count) {
+    if (modulation) {
+        for (int i = 0; i < count; i++) {
+            out[i] = tableSample(table, phase + modulation[i], amplitude);
+            phase += step;
+        }
+        return phase;
+    }
+    for (int i = 0; i < count; i++) {
+        out[i] = tableSample(table, phase, amplitude);
+        phase += step;
+    }
+    return phase;
+}
+
+// Reference unison kernel
+void renderUnisonScalar(const float* table, uint32_t* phases, const uint32_t* steps, const uint32_t* modulation,
+                        const float* gainsLeft, const float* gainsRight, int voices,
+                        float* outLeft, float* outRight, int count) {
+    unisonTail(table, phases, steps, modulation, gainsLeft, gainsRight, voices, outLeft, outRight, 0, count);
+    unisonAdvance(phases, steps, voices, count);
+}
+
+#ifdef AUDIOSYNTH_X86_KERNELS
+
+// SSE2 (baseline on x86-64): 4 samples per step, table reads done per lane (no gather)
+template <bool Modulated>
+static uint32_t tableSSE2(const float* table, uint32_t phase, uint32_t step, const uint32_t* modulation,
+                          float amplitude, float* out, int count) {
+    const __m128i vLaneStep = _mm_set1_epi32(static_cast<int>(step * 4u));
+    const __m128i vFracMask = _mm_set1_epi32(static_cast<int>(FRAC_MASK));
+    const __m128 vFracScale = _mm_set1_ps(FRAC_SCALE);
+    const __m128 vAmplitude = _mm_set1_ps(amplitude);
+    __m128i vPhase = _mm_setr_epi32(static_cast<int>(phase), static_cast<int>(phase + step),
+                                    static_cast<int>(phase + step * 2u), static_cast<int>(phase + step * 3u));
+    alignas(16) uint32_t index[4];
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i vRead = vPhase;
+        if constexpr (Modulated) {
+            vRead = _mm_add_epi32(vRead, _mm_loadu_si128(reinterpret_cast<const __m128i*>(modulation + i)));
+        }
+        _mm_store_si128(reinterpret_cast<__m128i*>(index), _mm_srli_epi32(vRead, FRAC_BITS));
+        __m128 frac = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(vRead, vFracMask)), vFracScale);
+        __m128 a = _mm_setr_ps(table[index[0]], table[index[1]], table[index[2]], table[index[3]]);
+        __m128 b = _mm_setr_ps(table[index[0] + 1], table[index[1] + 1], table[index[2] + 1], table[index[3] + 1]);
+        __m128 sample = _mm_add_ps(a, _mm_mul_ps(frac, _mm_sub_ps(b, a)));
+        _mm_storeu_ps(out + i, _mm_mul_ps(sample, vAmplitude));
+        vPhase = _mm_add_epi32(vPhase, vLaneStep);
+    }
+    phase += step * static_cast<uint32_t>(i);
+    return renderTableScalar(table, phase, step, Modulated ? modulation + i : nullptr, amplitude, out + i, count - i);
+}
+
+uint32_t renderTableSSE2(const float* table, uint32_t phase, uint32_t step, const uint32_t* modulation,
+                         float amplitude, float* out, int count) {
+    return modulation ? tableSSE2<true>(table, phase, step, modulation, amplitude, out, count)
+                      : tableSSE2<false>(table, phase, step, modulation, amplitude, out, count);
+}
+
+// SSE2 unison: 4 samples per step, each stacked voice added into the same accumulators
+template <bool Modulated>
+static void unisonSSE2(const float* table, uint32_t* phases, const uint32_t* steps, const uint32_t* modulation,
+                       const float* gainsLeft, const float* gainsRight, int voices,
+                       float* outLeft, float* outRight, int count) {
+    const __m128i vFracMask = _mm_set1_epi32(static_cast<int>(FRAC_MASK));
+    const __m128 vFracScale = _mm_set1_ps(FRAC_SCALE);
+    alignas(16) uint32_t index[4];
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i vOffset = _mm_setzero_si128();
+        if constexpr (Modulated) {
+            vOffset = _mm_loadu_si128(reinterpret_cast<const __m128i*>(modulation + i));
+        }
+        __m128 left = _mm_setzero_ps();
+        __m128 right = _mm_setzero_ps();
+        for (int v = 0; v < voices; v++) {
+            uint32_t p = phases[v] + steps[v] * static_cast<uint32_t>(i);
+            uint32_t s = steps[v];
+            __m128i vPhase = _mm_setr_epi32(static_cast<int>(p), static_cast<int>(p + s),
+                                            static_cast<int>(p + s * 2u), static_cast<int>(p + s * 3u));
+            if constexpr (Modulated) {
+                vPhase = _mm_add_epi32(vPhase, vOffset);
+            }
+            _mm_store_si128(reinterpret_cast<__m128i*>(index), _mm_srli_epi32(vPhase, FRAC_BITS));
+            __m128 frac = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(vPhase, vFracMask)), vFracScale);
+            __m128 a = _mm_setr_ps(table[index[0]], table[index[1]], table[index[2]], table[index[3]]);
+            __m128 b = _mm_setr_ps(table[index[0] + 1], table[index[1] + 1], table[index[2] + 1], table[index[3] + 1]);
+            __m128 sample = _mm_add_ps(a, _mm_mul_ps(frac, _mm_sub_ps(b, a)));
+            left = _mm_add_ps(left, _mm_mul_ps(sample, _mm_set1_ps(gainsLeft[v])));
+            right = _mm_add_ps(right, _mm_mul_ps(sample, _mm_set1_ps(gainsRight[v])));
+        }
+        _mm_storeu_ps(outLeft + i, left);
+        if (outRight) _mm_storeu_ps(outRight + i, right);
+    }
+    unisonTail(table, phases, steps, modulation, gainsLeft, gainsRight, voices, outLeft, outRight, i, count);
+    unisonAdvance(phases, steps, voices, count);
+}
+
+void renderUnisonSSE2(const float* table, uint32_t* phases, const uint32_t* steps, const uint32_t* modulation,
+                      const float* gainsLeft, const float* gainsRight, int voices,
+                      float* outLeft, float* outRight, int count) {
+    if (modulation) {
+        unisonSSE2<true>(table, phases, steps, modulation, gainsLeft, gainsRight, voices, outLeft, outRight, count);
+    } else {
+        unisonSSE2<false>(table, phases, steps, modulation, gainsLeft, gainsRight, voices, outLeft, outRight, count);
+    }
+}
+
+#endif // AUDIOSYNTH_X86_KERNELS
+
+// Widest instruction set this CPU and OS support (detected once)
+Isa detectIsa() {
+    static const Isa isa = [] {
+#if defined(AUDIOSYNTH_X86_KERNELS) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        bool osSavesAvx = (info[2] & (1 << 27)) != 0;
+        unsigned long long xcr0 = osSavesAvx ? _xgetbv(0) : 0;
+        __cpuidex(info, 7, 0);
+        if ((info[1] & (1 << 16)) && (xcr0 & 0xE6) == 0xE6) return Isa::AVX512;
+        if ((info[1] & (1 << 5)) && (xcr0 & 0x6) == 0x6) return Isa::AVX2;
+        return Isa::SSE2;
+#elif defined(AUDIOSYNTH_X86_KERNELS)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return Isa::AVX512;
+        if (__builtin_cpu_supports("avx2")) return Isa::AVX2;
+        return Isa::SSE2;
+#else
+        return Isa::Scalar;
+#endif
+    }();
+    return isa;
+}
+
+const char* isaName(Isa isa) {
+    switch (isa) {
+        case Isa::SSE2: return "sse2";
+        case Isa::AVX2: return "avx2";
+        case Isa::AVX512: return "avx512";
+        case Isa::Scalar: break;
+    }
+    return "scalar";
+}
+
+// Kernels for an instruction set (must not be wider than detectIsa())
+TableKernel tableKernel(Isa isa) {
+    switch (isa) {
+#ifdef AUDIOSYNTH_X86_KERNELS
+        case Isa::SSE2: return renderTableSSE2;
+        case Isa::AVX2: return renderTableAVX2;
+        case Isa::AVX512: return renderTableAVX512;
+#endif
+        default: return renderTableScalar;
+    }
+}
+
+UnisonKernel unisonKernel(Isa isa) {
+    switch (isa) {
+#ifdef AUDIOSYNTH_X86_KERNELS
+        case Isa::SSE2: return renderUnisonSSE2;
+        case Isa::AVX2: return renderUnisonAVX2;
+        case Isa::AVX512: return renderUnisonAVX512;
+#endif
+        default: return renderUnisonScalar;
+    }
+}
+
+} // namespace OscillatorKernels
@@ -0,0 +1,96 @@
+// AVX2 wavetable kernel: built with AVX2 enabled, only called when detectIsa() reports it
+#include "include/OscillatorKernels.h"
+
+#ifdef AUDIOSYNTH_X86_KERNELS
+#include <immintrin.h>
+
+namespace OscillatorKernels {
+
+// 8 samples per step, both interpolation taps fetched with one gather each
+template <bool Modulated>
+static uint32_t tableAVX2(const float* table, uint32_t phase, uint32_t step, const uint32_t* modulation,
+                          float amplitude, float* out, int count) {
+    const __m256i vLaneStep = _mm256_set1_epi32(static_cast<int>(step * 8u));
+    const __m256i vFracMask = _mm256_set1_epi32(static_cast<int>(FRAC_MASK));
+    const __m256 vFracScale = _mm256_set1_ps(FRAC_SCALE);
+    const __m256 vAmplitude = _mm256_set1_ps(amplitude);
+    __m256i vPhase = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(phase)),
+                                      _mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(step)),
+                                                         _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i vRead = vPhase;
+        if constexpr (Modulated) {
+            vRead = _mm256_add_epi32(vRead, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(modulation + i)));
+        }
+        __m256i vIndex = _mm256_srli_epi32(vRead, FRAC_BITS);
+        __m256 frac = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(vRead, vFracMask)), vFracScale);
+        __m256 a = _mm256_i32gather_ps(table, vIndex, 4);
+        __m256 b = _mm256_i32gather_ps(table + 1, vIndex, 4);
+        __m256 sample = _mm256_add_ps(a, _mm256_mul_ps(frac, _mm256_sub_ps(b, a)));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(sample, vAmplitude));
+        vPhase = _mm256_add_epi32(vPhase, vLaneStep);
+    }
+    phase += step * static_cast<uint32_t>(i);
+    return renderTableScalar(table, phase, step, Modulated ? modulation + i : nullptr, amplitude, out + i, count - i);
+}
+
+uint32_t renderTableAVX2(const float* table, uint32_t phase, uint32_t step, const uint32_t* modulation,
+                         float amplitude, float* out, int count) {
+    return modulation ? tableAVX2<true>(table, phase, step, modulation, amplitude, out, count)
+                      : tableAVX2<false>(table, phase, step, modulation, amplitude, out, count);
+}
+
+// 8 samples per step, each stacked voice added into the same accumulators
+template <bool Modulated>
+static void unisonAVX2(const float* table, uint32_t* phases, const uint32_t* steps, const uint32_t* modulation,
+                       const float* gainsLeft, const float* gainsRight, int voices,
+                       float* outLeft, float* outRight, int count) {
+    const __m256i vFracMask = _mm256_set1_epi32(static_cast<int>(FRAC_MASK));
+    const __m256 vFracScale = _mm256_set1_ps(FRAC_SCALE);
+    const __m256i vLanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i vOffset = _mm256_setzero_si256();
+        if constexpr (Modulated) {
+            vOffset = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(modulation + i));
+        }
+        __m256 left = _mm256_setzero_ps();
+        __m256 right = _mm256_setzero_ps();
+        for (int v = 0; v < voices; v++) {
+            uint32_t p = phases[v] + steps[v] * static_cast<uint32_t>(i);
+            __m256i vPhase = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(p)),
+                                              _mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(steps[v])), vLanes));
+            if constexpr (Modulated) {
+                vPhase = _mm256_add_epi32(vPhase, vOffset);
+            }
+            __m256i vIndex = _mm256_srli_epi32(vPhase, FRAC_BITS);
+            __m256 frac = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(vPhase, vFracMask)), vFracScale);
+            __m256 a = _mm256_i32gather_ps(table, vIndex, 4);
+            __m256 b = _mm256_i32gather_ps(table + 1, vIndex, 4);
+            __m256 sample = _mm256_add_ps(a, _mm256_mul_ps(frac, _mm256_sub_ps(b, a)));
+            left = _mm256_add_ps(left, _mm256_mul_ps(sample, _mm256_set1_ps(gainsLeft[v])));
+            right = _mm256_add_ps(right, _mm256_mul_ps(sample, _mm256_set1_ps(gainsRight[v])));
+        }
+        _mm256_storeu_ps(outLeft + i, left);
+        if (outRight) _mm256_storeu_ps(outRight + i, right);
+    }
+    unisonTail(table, phases, steps, modulation, gainsLeft, gainsRight, voices, outLeft, outRight, i, count);
+    unisonAdvance(phases, steps, voices, count);
+}
+
+void renderUnisonAVX2(const float* table, uint32_t* phases, const uint32_t* steps, const uint32_t* modulation,
+                      const float* gainsLeft, const float* gainsRight, int voices,
+                      float* outLeft, float* outRight, int count) {
+    if (modulation) {
+        unisonAVX2<true>(table, phases, steps, modulation, gainsLeft, gainsRight, voices, outLeft, outRight, count);
+    } else {
+        unisonAVX2<false>(table, phases, steps, modulation, gainsLeft, gainsRight, voices, outLeft, outRight, count);
+    }
+}
+
+} // namespace OscillatorKernels
+
+#endif // AUDIOSYNTH_X86_KERNELS
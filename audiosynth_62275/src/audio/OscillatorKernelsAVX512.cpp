@@ -0,0 +1,97 @@
+// AVX-512 wavetable kernel: built with AVX-512F enabled, only called when detectIsa() reports it
+#include "include/OscillatorKernels.h"
+
+#ifdef AUDIOSYNTH_X86_KERNELS
+#include <immintrin.h>
+
+namespace OscillatorKernels {
+
+// 16 samples per step, both interpolation taps fetched with one gather each
+template <bool Modulated>
+static uint32_t tableAVX512(const float* table, uint32_t phase, uint32_t step, const uint32_t* modulation,
+                            float amplitude, float* out, int count) {
+    const __m512i vLaneStep = _mm512_set1_epi32(static_cast<int>(step * 16u));
+    const __m512i vFracMask = _mm512_set1_epi32(static_cast<int>(FRAC_MASK));
+    const __m512 vFracScale = _mm512_set1_ps(FRAC_SCALE);
+    const __m512 vAmplitude = _mm512_set1_ps(amplitude);
+    __m512i vPhase = _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(phase)),
+                                      _mm512_mullo_epi32(_mm512_set1_epi32(static_cast<int>(step)),
+                                                         _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7,
+                                                                           8, 9, 10, 11, 12, 13, 14, 15)));
+
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512i vRead = vPhase;
+        if constexpr (Modulated) {
+            vRead = _mm512_add_epi32(vRead, _mm512_loadu_si512(modulation + i));
+        }
+        __m512i vIndex = _mm512_srli_epi32(vRead, FRAC_BITS);
+        __m512 frac = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_and_si512(vRead, vFracMask)), vFracScale);
+        __m512 a = _mm512_i32gather_ps(vIndex, table, 4);
+        __m512 b = _mm512_i32gather_ps(vIndex, table + 1, 4);
+        __m512 sample = _mm512_add_ps(a, _mm512_mul_ps(frac, _mm512_sub_ps(b, a)));
+        _mm512_storeu_ps(out + i, _mm512_mul_ps(sample, vAmplitude));
+        vPhase = _mm512_add_epi32(vPhase, vLaneStep);
+    }
+    phase += step * static_cast<uint32_t>(i);
+    return renderTableScalar(table, phase, step, Modulated ? modulation + i : nullptr, amplitude, out + i, count - i);
+}
+
+uint32_t renderTableAVX512(const float* table, uint32_t phase, uint32_t step, const uint32_t* modulation,
+                           float amplitude, float* out, int count) {
+    return modulation ? tableAVX512<true>(table, phase, step, modulation, amplitude, out, count)
+                      : tableAVX512<false>(table, phase, step, modulation, amplitude, out, count);
+}
+
+// 16 samples per step, each stacked voice added into the same accumulators
+template <bool Modulated>
+static void unisonAVX512(const float* table, uint32_t* phases, const uint32_t* steps, const uint32_t* modulation,
+                         const float* gainsLeft, const float* gainsRight, int voices,
+                         float* outLeft, float* outRight, int count) {
+    const __m512i vFracMask = _mm512_set1_epi32(static_cast<int>(FRAC_MASK));
+    const __m512 vFracScale = _mm512_set1_ps(FRAC_SCALE);
+    const __m512i vLanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512i vOffset = _mm512_setzero_si512();
+        if constexpr (Modulated) {
+            vOffset = _mm512_loadu_si512(modulation + i);
+        }
+        __m512 left = _mm512_setzero_ps();
+        __m512 right = _mm512_setzero_ps();
+        for (int v = 0; v < voices; v++) {
+            uint32_t p = phases[v] + steps[v] * static_cast<uint32_t>(i);
+            __m512i vPhase = _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(p)),
+                                              _mm512_mullo_epi32(_mm512_set1_epi32(static_cast<int>(steps[v])), vLanes));
+            if constexpr (Modulated) {
+                vPhase = _mm512_add_epi32(vPhase, vOffset);
+            }
+            __m512i vIndex = _mm512_srli_epi32(vPhase, FRAC_BITS);
+            __m512 frac = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_and_si512(vPhase, vFracMask)), vFracScale);
+            __m512 a = _mm512_i32gather_ps(vIndex, table, 4);
+            __m512 b = _mm512_i32gather_ps(vIndex, table + 1, 4);
+            __m512 sample = _mm512_add_ps(a, _mm512_mul_ps(frac, _mm512_sub_ps(b, a)));
+            left = _mm512_add_ps(left, _mm512_mul_ps(sample, _mm512_set1_ps(gainsLeft[v])));
+            right = _mm512_add_ps(right, _mm512_mul_ps(sample, _mm512_set1_ps(gainsRight[v])));
+        }
+        _mm512_storeu_ps(outLeft + i, left);
+        if (outRight) _mm512_storeu_ps(outRight + i, right);
+    }
+    unisonTail(table, phases, steps, modulation, gainsLeft, gainsRight, voices, outLeft, outRight, i, count);
+    unisonAdvance(phases, steps, voices, count);
+}
+
+void renderUnisonAVX512(const float* table, uint32_t* phases, const uint32_t* steps, const uint32_t* modulation,
+                        const float* gainsLeft, const float* gainsRight, int voices,
+                        float* outLeft, float* outRight, int count) {
+    if (modulation) {
+        unisonAVX512<true>(table, phases, steps, modulation, gainsLeft, gainsRight, voices, outLeft, outRight, count);
+    } else {
+        unisonAVX512<false>(table, phases, steps, modulation, gainsLeft, gainsRight, voices, outLeft, outRight, count);
+    }
+}
+
+} // namespace OscillatorKernels
+
+#endif // AUDIOSYNTH_X86_KERNELS
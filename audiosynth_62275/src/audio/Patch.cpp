@@ -0,0 +1,155 @@
+#include "include/Patch.h"
+#include "include/SynthEngine.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+// Patch keys mapped onto SynthParams fields
+struct FloatField { const char* key; float SynthParams::* field; };
+struct IntField { const char* key; int SynthParams::* field; };
+struct BoolField { const char* key; bool SynthParams::* field; };
+
+const FloatField FLOAT_FIELDS[] = {
+    { "attack", &SynthParams::attack },
+    { "decay", &SynthParams::decay },
+    { "sustain", &SynthParams::sustain },
+    { "release", &SynthParams::release },
+    { "filter_cutoff", &SynthParams::filter_cutoff },
+    { "filter_resonance", &SynthParams::filter_resonance },
+    { "filter_auto_variation_frequency", &SynthParams::filter_auto_variation_frequency },
+    { "filter_auto_variation_amount", &SynthParams::filter_auto_variation_amount },
+    { "filter_drive", &SynthParams::filter_drive },
+    { "volume", &SynthParams::volume },
+    { "osc1_frequency_offset", &SynthParams::osc1_frequency_offset },
+    { "osc2_frequency_offset", &SynthParams::osc2_frequency_offset },
+    { "osc3_frequency_offset", &SynthParams::osc3_frequency_offset },
+    { "osc1_unison_detune", &SynthParams::osc1_unison_detune },
+    { "osc2_unison_detune", &SynthParams::osc2_unison_detune },
+    { "osc3_unison_detune", &SynthParams::osc3_unison_detune },
+    { "osc1_unison_spread", &SynthParams::osc1_unison_spread },
+    { "osc2_unison_spread", &SynthParams::osc2_unison_spread },
+    { "osc3_unison_spread", &SynthParams::osc3_unison_spread },
+    { "osc2_mod_index", &SynthParams::osc2_mod_index },
+    { "osc3_mod_index", &SynthParams::osc3_mod_index },
+    { "osc_mix", &SynthParams::osc_mix },
+};
+
+const IntField INT_FIELDS[] = {
+    { "osc1_waveform", &SynthParams::osc1_waveform },
+    { "osc2_waveform", &SynthParams::osc2_waveform },
+    { "osc3_waveform", &SynthParams::osc3_waveform },
+    { "osc1_unison", &SynthParams::osc1_unison },
+    { "osc2_unison", &SynthParams::osc2_unison },
+    { "osc3_unison", &SynthParams::osc3_unison },
+    { "fm_algorithm", &SynthParams::fm_algorithm },
+    { "envelope_curve", &SynthParams::envelope_curve },
+    { "filter_type", &SynthParams::filter_type },
+    { "filter_mode", &SynthParams::filter_mode },
+    { "filter_oversampling", &SynthParams::filter_oversampling },
+    { "voice_count", &SynthParams::voice_count },
+    { "voice_steal_policy", &SynthParams::voice_steal_policy },
+};
+
+const BoolField BOOL_FIELDS[] = {
+    { "osc1_enabled", &SynthParams::osc1_enabled },
+    { "osc2_enabled", &SynthParams::osc2_enabled },
+    { "osc3_enabled", &SynthParams::osc3_enabled },
+};
+
+// Assign one "key = value" pair, returns false for an unknown key
+bool setField(Patch& patch, const std::string& key, double value) {
+    if (key == "sample_rate") {
+        patch.sampleRate = value;
+        return true;
+    }
+    if (key == "seed") {
+        patch.seed = static_cast<uint32_t>(value);
+        return true;
+    }
+    for (const auto& f : FLOAT_FIELDS) {
+        if (key == f.key) { patch.params.*f.field = static_cast<float>(value); return true; }
+    }
+    for (const auto& f : INT_FIELDS) {
+        if (key == f.key) { patch.params.*f.field = static_cast<int>(value); return true; }
+    }
+    for (const auto& f : BOOL_FIELDS) {
+        if (key == f.key) { patch.params.*f.field = value != 0.0; return true; }
+    }
+    return false;
+}
+
+} // namespace
+
+// Load a patch file; returns false and describes the problem in error
+bool Patch::load(const std::string& path, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open patch file " + path;
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        line = line.substr(0, line.find('#'));
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            if (line.find_first_not_of(" \t\r") != std::string::npos) {
+                error = path + ":" + std::to_string(lineNumber) + ": expected key = value";
+                return false;
+            }
+            continue;
+        }
+
+        std::string key;
+        double value = 0.0;
+        std::istringstream keyStream(line.substr(0, equals));
+        std::istringstream valueStream(line.substr(equals + 1));
+        if ((keyStream >> key) && (key == "scale" || key == "keyboard_mapping")) {
+            // Tuning files: the value is a path, relative to the patch file's directory
+            std::string file;
+            if (!(valueStream >> file)) {
+                error = path + ":" + std::to_string(lineNumber) + ": missing file for '" + key + "'";
+                return false;
+            }
+            std::string resolved = (std::filesystem::path(path).parent_path() / file).string();
+            bool loaded = key == "scale" ? tuning.loadScale(resolved, error)
+                                         : tuning.loadKeyboardMapping(resolved, error);
+            if (!loaded) return false;
+            continue;
+        }
+        if (key.empty() || !(valueStream >> value) || !setField(*this, key, value)) {
+            error = path + ":" + std::to_string(lineNumber) + ": invalid entry '" + key + "'";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Publish the parameters and queue the oscillator settings on an engine
+void Patch::apply(SynthEngine& engine, SynthParamsBuffer& buffer) const {
+    buffer.publish(params);
+    engine.setTuning(tuning);
+    engine.postEvent({SynthEvent::Type::SetSeed, 0, static_cast<double>(seed)});
+    engine.postEvent({SynthEvent::Type::SetAlgorithm, 0, static_cast<double>(params.fm_algorithm)});
+    engine.postEvent({SynthEvent::Type::SetOscModIndex, 1, params.osc2_mod_index});
+    engine.postEvent({SynthEvent::Type::SetOscModIndex, 2, params.osc3_mod_index});
+
+    const bool enabled[] = { params.osc1_enabled, params.osc2_enabled, params.osc3_enabled };
+    const int waveforms[] = { params.osc1_waveform, params.osc2_waveform, params.osc3_waveform };
+    const float offsets[] = { params.osc1_frequency_offset, params.osc2_frequency_offset, params.osc3_frequency_offset };
+    const int unison[] = { params.osc1_unison, params.osc2_unison, params.osc3_unison };
+    const float detune[] = { params.osc1_unison_detune, params.osc2_unison_detune, params.osc3_unison_detune };
+    const float spread[] = { params.osc1_unison_spread, params.osc2_unison_spread, params.osc3_unison_spread };
+    for (int osc = 0; osc < 3; osc++) {
+        engine.postEvent({SynthEvent::Type::SetOscEnabled, osc, enabled[osc] ? 1.0 : 0.0});
+        engine.postEvent({SynthEvent::Type::SetOscWaveform, osc, static_cast<double>(waveforms[osc])});
+        engine.postEvent({SynthEvent::Type::SetOscFrequencyOffset, osc, offsets[osc]});
+        engine.postEvent({SynthEvent::Type::SetOscUnison, osc, static_cast<double>(unison[osc])});
+        engine.postEvent({SynthEvent::Type::SetOscUnisonDetune, osc, detune[osc]});
+        engine.postEvent({SynthEvent::Type::SetOscUnisonSpread, osc, spread[osc]});
+    }
+}
@@ -0,0 +1,106 @@
+#include "include/SmoothedValue.h"
+#include "include/SynthConstants.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Share of the jump a one-pole ramp has left when its time is up (about -80 dB);
+// the ramp then lands on the target
+constexpr double ONE_POLE_RESIDUE = 0.0001;
+
+} // namespace
+
+// Constructor: settled on 'initial'
+SmoothedValue::SmoothedValue(float initial, Curve curve)
+    : curve(curve),
+      sampleRate(static_cast<float>(SynthConstants::DEFAULT_SAMPLE_RATE)),
+      smoothingTime(0.0f),
+      current(initial),
+      target(initial),
+      rampStart(initial),
+      rampStep(0.0f),
+      decay(0.0f),
+      rampLength(1),
+      position(1) {
+}
+
+// Set the sample rate (in Hz)
+// Only stored: a ramp already running keeps its length, and a settled value stays settled
+void SmoothedValue::setSampleRate(float sr) {
+    sampleRate = sr;
+}
+
+// Set the smoothing time (in seconds), stored like the sample rate
+void SmoothedValue::setSmoothingTime(float seconds) {
+    smoothingTime = std::max(0.0f, seconds);
+}
+
+// Glide from the current value to a new target over the smoothing time
+// A ramp already running restarts from where it got to
+void SmoothedValue::setTarget(float newTarget) {
+    if (newTarget == target) return;
+    target = newTarget;
+    rampLength = std::max(1, static_cast<int>(std::lround(smoothingTime * sampleRate)));
+    position = 0;
+    rampStart = current;
+    rampStep = (target - current) / static_cast<float>(rampLength);
+    decay = static_cast<float>(std::exp(std::log(ONE_POLE_RESIDUE) / rampLength));
+}
+
+// Jump to a value at once, ending any ramp
+void SmoothedValue::setImmediate(float value) {
+    current = target = value;
+    position = rampLength;
+}
+
+// Current value, without advancing
+float SmoothedValue::getCurrent() const {
+    return current;
+}
+
+// Value the ramp ends on
+float SmoothedValue::getTarget() const {
+    return target;
+}
+
+// True while the value is still moving towards the target
+bool SmoothedValue::isSmoothing() const {
+    return position < rampLength;
+}
+
+// Advance 'frames' samples and return the value reached
+// Lands on the same values as fill() over the same samples, however they are split
+float SmoothedValue::advance(int frames) {
+    if (isSmoothing()) {
+        step(std::min(frames, rampLength - position));
+    }
+    return current;
+}
+
+// Write the value of each of the next 'count' samples and advance past them
+// Settled, this is a constant fill
+void SmoothedValue::fill(float* values, int count) {
+    int i = 0;
+    for (; i < count && isSmoothing(); i++) {
+        values[i] = step(1);
+    }
+    std::fill(values + i, values + count, current);
+}
+
+// Value 'steps' samples further along the current ramp (steps <= remaining)
+float SmoothedValue::step(int steps) {
+    if (curve == Curve::Linear) {
+        position += steps;
+        current = rampStart + rampStep * static_cast<float>(position);
+    } else {
+        for (int i = 0; i < steps; i++) {
+            current = target + (current - target) * decay;
+        }
+        position += steps;
+    }
+    if (position >= rampLength) {
+        current = target;
+    }
+    return current;
+}
@@ -0,0 +1,231 @@
+#include "include/StateVariableFilter.h"
+#include "include/SynthConstants.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// State level below which the filter output is treated as silence (about -140 dB)
+constexpr float SILENCE_THRESHOLD = 1.0e-7f;
+
+// Highest warped cutoff, pi * 0.49: just below Nyquist, where tan() has its pole
+constexpr float MAX_WARP = static_cast<float>(M_PI * 0.49);
+
+// Samples of modulated cutoff worked out per pass when the LFO runs
+constexpr int LFO_CHUNK = SynthConstants::RENDER_BLOCK_SIZE;
+
+// Coefficients of one sample, worked out from the cutoff
+struct Coefficients {
+    float a1, a2, a3;
+};
+
+// a1 = 1 / (1 + g * (g + k)), a2 = g * a1, a3 = g * a2 with g = tan(pi * cutoff / sampleRate)
+// tan is the [5/4] Pade approximant n / d (error below 1e-4 up to MAX_WARP), and all three
+// coefficients share the denominator d^2 + n * (n + k * d), so the cost is one division
+inline Coefficients coefficients(float cutoff, float piOverRate, float k) {
+    float x = std::clamp(cutoff * piOverRate, 0.0f, MAX_WARP);
+    float x2 = x * x;
+    float n = x * (945.0f + x2 * (-105.0f + x2));
+    float d = 945.0f + x2 * (-420.0f + x2 * 15.0f);
+    float inv = 1.0f / (d * d + n * (n + k * d));
+    return { d * d * inv, n * d * inv, n * n * inv };
+}
+
+// Sine of a 32-bit phase (2^32 = one cycle), odd polynomial after folding into [-pi/2, pi/2]
+// Error below 1e-5, far below what the cutoff modulation can resolve
+inline float phaseSin(uint32_t phase) {
+    constexpr float PHASE_TO_RADIANS = static_cast<float>(SynthConstants::TWO_PI / SynthConstants::PHASE_CYCLE);
+    constexpr auto HALF_PI = static_cast<float>(M_PI / 2.0);
+    constexpr auto PI = static_cast<float>(M_PI);
+    float x = static_cast<float>(static_cast<int32_t>(phase)) * PHASE_TO_RADIANS;
+    if (x > HALF_PI) x = PI - x;
+    else if (x < -HALF_PI) x = -PI - x;
+    float x2 = x * x;
+    return x * (1.0f + x2 * (-1.0f / 6.0f + x2 * (1.0f / 120.0f + x2 * (-1.0f / 5040.0f + x2 * (1.0f / 362880.0f)))));
+}
+
+} // namespace
+
+// Constructor initializing sample rate and default parameters
+StateVariableFilter::StateVariableFilter(float sampleRate)
+    : sampleRate(sampleRate),
+      cutoff(1000.0f),
+      resonance(0.5f),
+      mode(Mode::LowPass),
+      lfoFrequency(0.0f),
+      lfoAmount(0.0f),
+      lfoPhase(0),
+      lfoStep(0),
+      k(1.0f),
+      a1(0.0f),
+      a2(0.0f),
+      a3(0.0f),
+      mixInput(0.0f),
+      mixBand(0.0f),
+      mixLow(1.0f),
+      ic1eq(0.0f),
+      ic2eq(0.0f) {
+    updateMix();
+    updateCoefficients();
+}
+
+// Set the sample rate (in Hz) and recalculate coefficients
+void StateVariableFilter::setSampleRate(float newSampleRate) {
+    sampleRate = newSampleRate;
+    updateLFOStep();
+    updateCoefficients();
+}
+
+// Set a new cutoff frequency (in Hz)
+// Parameters are re-applied every block, so unchanged values return early
+void StateVariableFilter::setCutoff(float newCutoff) {
+    if (newCutoff == cutoff) return;
+    cutoff = newCutoff;
+    updateCoefficients();
+}
+
+// Set a new resonance (0.0 to 0.99, same Q mapping as LowPassFilter)
+void StateVariableFilter::setResonance(float newResonance) {
+    if (newResonance == resonance) return;
+    resonance = newResonance;
+    updateMix();
+    updateCoefficients();
+}
+
+// Select the output mode
+void StateVariableFilter::setMode(Mode newMode) {
+    if (newMode == mode) return;
+    mode = newMode;
+    updateMix();
+}
+
+// Set LFO frequency for automatic cutoff variation
+void StateVariableFilter::setAutoVariationFrequency(float frequency) {
+    if (frequency == lfoFrequency) return;
+    lfoFrequency = frequency;
+    updateLFOStep();
+}
+
+// Set LFO amount for automatic cutoff variation
+void StateVariableFilter::setAutoVariationAmount(float amount) {
+    lfoAmount = amount;
+}
+
+// Reset filter state
+void StateVariableFilter::reset() {
+    ic1eq = ic2eq = 0.0f;
+    lfoPhase = 0; // Reset LFO phase
+}
+
+// Process a single input sample and return the filtered output
+float StateVariableFilter::process(float input) {
+    processBlock(&input, 1);
+    return input;
+}
+
+// Filter a buffer in place, same result as process() on each sample
+// The LFO works out a cutoff per sample and hands them to the modulated loop
+void StateVariableFilter::processBlock(float* samples, int count) {
+    if (lfoActive()) {
+        // Same modulation as LowPassFilter: +-5000 Hz at amount 1.0, clamped to 20 Hz - 20 kHz
+        float depth = lfoAmount * 5000.0f;
+        float cutoffs[LFO_CHUNK];
+        for (int i = 0; i < count; i += LFO_CHUNK) {
+            int run = std::min(count - i, LFO_CHUNK);
+            for (int j = 0; j < run; j++) {
+                lfoPhase += lfoStep;  // Unsigned wraparound is the cycle wrap
+                cutoffs[j] = std::clamp(cutoff + phaseSin(lfoPhase) * depth, 20.0f, 20000.0f);
+            }
+            processBlock(samples + i, cutoffs, run);
+        }
+        return;
+    }
+
+    float s1 = ic1eq, s2 = ic2eq;  // State kept in registers
+    for (int i = 0; i < count; i++) {
+        float input = samples[i];
+        float v3 = input - s2;
+        float band = a1 * s1 + a2 * v3;
+        float low = s2 + a2 * s1 + a3 * v3;
+        s1 = 2.0f * band - s1;
+        s2 = 2.0f * low - s2;
+        samples[i] = mixInput * input + mixBand * band + mixLow * low;
+    }
+    ic1eq = s1;
+    ic2eq = s2;
+}
+
+// Filter a buffer in place with a cutoff in Hz per sample (audio-rate modulation)
+void StateVariableFilter::processBlock(float* samples, const float* cutoffs, int count) {
+    float piOverRate = static_cast<float>(M_PI) / sampleRate;
+    float s1 = ic1eq, s2 = ic2eq;
+    for (int i = 0; i < count; i++) {
+        Coefficients c = coefficients(cutoffs[i], piOverRate, k);
+        float input = samples[i];
+        float v3 = input - s2;
+        float band = c.a1 * s1 + c.a2 * v3;
+        float low = s2 + c.a2 * s1 + c.a3 * v3;
+        s1 = 2.0f * band - s1;
+        s2 = 2.0f * low - s2;
+        samples[i] = mixInput * input + mixBand * band + mixLow * low;
+    }
+    ic1eq = s1;
+    ic2eq = s2;
+}
+
+// True once the state has decayed below audibility
+bool StateVariableFilter::isSettled() const {
+    return std::fabs(ic1eq) < SILENCE_THRESHOLD && std::fabs(ic2eq) < SILENCE_THRESHOLD;
+}
+
+// Stand-in for process() over 'frames' samples of silence once settled
+// The LFO lands on the same phase as per-sample processing would
+void StateVariableFilter::skipSilence(int frames) {
+    ic1eq = ic2eq = 0.0f;
+    if (lfoActive()) {
+        lfoPhase += lfoStep * static_cast<uint32_t>(frames);
+    }
+}
+
+// Recalculate the coefficients for the set cutoff
+void StateVariableFilter::updateCoefficients() {
+    Coefficients c = coefficients(cutoff, static_cast<float>(M_PI) / sampleRate, k);
+    a1 = c.a1;
+    a2 = c.a2;
+    a3 = c.a3;
+}
+
+// Recalculate the damping and the output mix from resonance and mode
+// With high = input - k * band - low, every mode is a mix of input, band and low
+void StateVariableFilter::updateMix() {
+    // Q = 0.5 / (1 - resonance) as in LowPassFilter, so k = 1 / Q
+    k = 2.0f * (1.0f - resonance);
+    switch (mode) {
+        case Mode::LowPass:
+            mixInput = 0.0f; mixBand = 0.0f; mixLow = 1.0f;
+            break;
+        case Mode::HighPass:
+            mixInput = 1.0f; mixBand = -k; mixLow = -1.0f;
+            break;
+        case Mode::BandPass:
+            mixInput = 0.0f; mixBand = k; mixLow = 0.0f;
+            break;
+        case Mode::Notch:
+            mixInput = 1.0f; mixBand = -k; mixLow = 0.0f;
+            break;
+        case Mode::Peak:
+            mixInput = -1.0f; mixBand = k; mixLow = 2.0f;
+            break;
+    }
+}
+
+// True while the LFO modulates the cutoff
+bool StateVariableFilter::lfoActive() const {
+    return lfoFrequency >= 1.0f && lfoAmount > 0.0f;
+}
+
+// Recompute the LFO phase increment from its frequency and the sample rate
+void StateVariableFilter::updateLFOStep() {
+    lfoStep = static_cast<uint32_t>(static_cast<int64_t>(std::llround(
+        static_cast<double>(lfoFrequency) / sampleRate * SynthConstants::PHASE_CYCLE)));
+}
@@ -0,0 +1,347 @@
+#include "include/SynthEngine.h"
+#include <algorithm>
+#include <chrono>
+#include <initializer_list>
+
+// Constructor: reads parameter snapshots from the given buffer
+SynthEngine::SynthEngine(SynthParamsBuffer* params, double sampleRate)
+    : params(params),
+      filter(static_cast<float>(sampleRate)),
+      filterRight(static_cast<float>(sampleRate)),
+      ladder(static_cast<float>(sampleRate)),
+      sampleRate(sampleRate) {
+    voices.setSampleRate(sampleRate);
+    volume.setSmoothingTime(SynthConstants::VOLUME_SMOOTHING_TIME);
+    cutoff.setSmoothingTime(SynthConstants::CUTOFF_SMOOTHING_TIME);
+    resonance.setSmoothingTime(SynthConstants::RESONANCE_SMOOTHING_TIME);
+    for (SmoothedValue* value : { &volume, &cutoff, &resonance }) {
+        value->setSampleRate(static_cast<float>(sampleRate));
+    }
+}
+
+// Change the sample rate of every DSP module
+void SynthEngine::setSampleRate(double sr) {
+    sampleRate = sr;
+    voices.setSampleRate(sr);
+    for (FilterChannel* channel : { &filter, &filterRight }) {
+        channel->biquad.setSampleRate(static_cast<float>(sr));
+        channel->svf.setSampleRate(static_cast<float>(sr));
+    }
+    ladder.setSampleRate(static_cast<float>(sr));
+    for (SmoothedValue* value : { &volume, &cutoff, &resonance }) {
+        value->setSampleRate(static_cast<float>(sr));
+    }
+    // Restart the frameTime() extrapolation at the new rate
+    clockNanos.store(0, std::memory_order_relaxed);
+}
+
+double SynthEngine::getSampleRate() const {
+    return sampleRate;
+}
+
+// Control thread: replace the note tuning (frequency of every MIDI note)
+void SynthEngine::setTuning(const Tuning& tuning) {
+    tunings.publish(tuning);
+}
+
+// Control thread: queue an event for the audio thread
+bool SynthEngine::postEvent(const SynthEvent& event) {
+    return events.push(event);
+}
+
+// Any thread: engine frame at which an event posted now should take effect
+uint64_t SynthEngine::frameTime() const {
+    uint32_t sequence;
+    uint64_t frame;
+    int64_t nanos;
+    uint32_t block;
+    uint32_t rate;
+    do {
+        sequence = clockSequence.load(std::memory_order_acquire);
+        frame = clockFrame.load(std::memory_order_relaxed);
+        nanos = clockNanos.load(std::memory_order_relaxed);
+        block = clockBlock.load(std::memory_order_relaxed);
+        rate = clockRate.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((sequence & 1) != 0 || sequence != clockSequence.load(std::memory_order_relaxed));
+
+    // Stream not running yet: apply as soon as rendering starts
+    if (nanos == 0) {
+        return 0;
+    }
+
+    // Position inside the current block, clamped so a stalled stream cannot push events far ahead
+    int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto elapsed = static_cast<uint64_t>(std::max<int64_t>(0, now - nanos) * rate / 1000000000);
+    return frame + std::min<uint64_t>(elapsed, block) + block;
+}
+
+// Publish the block start position for frameTime()
+void SynthEngine::publishClock(unsigned long frames) {
+    int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    clockSequence.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    clockFrame.store(frameCount, std::memory_order_relaxed);
+    clockNanos.store(now, std::memory_order_relaxed);
+    clockBlock.store(static_cast<uint32_t>(frames), std::memory_order_relaxed);
+    clockRate.store(static_cast<uint32_t>(sampleRate), std::memory_order_relaxed);
+    clockSequence.fetch_add(1, std::memory_order_release);
+}
+
+// Apply one queued event to the DSP state
+void SynthEngine::applyEvent(const SynthEvent& event) {
+    switch (event.type) {
+        case SynthEvent::Type::NoteOn:
+            voices.noteOn(event.note);
+            break;
+        case SynthEvent::Type::NoteOff:
+            if (event.note < 0) voices.allNotesOff();
+            else voices.noteOff(event.note);
+            break;
+        case SynthEvent::Type::SetOscEnabled:
+            voices.setOscEnabled(event.oscillator, event.value != 0.0);
+            break;
+        case SynthEvent::Type::SetOscWaveform:
+            voices.setOscWaveform(event.oscillator, static_cast<Oscillator::Waveform>(static_cast<int>(event.value)));
+            break;
+        case SynthEvent::Type::SetOscFrequencyOffset:
+            voices.setOscFrequencyOffset(event.oscillator, static_cast<float>(event.value));
+            break;
+        case SynthEvent::Type::SetOscUnison:
+            voices.setOscUnison(event.oscillator, static_cast<int>(event.value));
+            break;
+        case SynthEvent::Type::SetOscUnisonDetune:
+            voices.setOscUnisonDetune(event.oscillator, static_cast<float>(event.value));
+            break;
+        case SynthEvent::Type::SetOscUnisonSpread:
+            voices.setOscUnisonSpread(event.oscillator, static_cast<float>(event.value));
+            break;
+        case SynthEvent::Type::SetOscModIndex:
+            voices.setOscModIndex(event.oscillator, static_cast<float>(event.value));
+            break;
+        case SynthEvent::Type::SetAlgorithm:
+            voices.setAlgorithm(static_cast<TripleOscillator::Algorithm>(static_cast<int>(event.value)));
+            break;
+        case SynthEvent::Type::SetSeed:
+            voices.setSeed(static_cast<uint32_t>(event.value));
+            break;
+    }
+}
+
+// Audio thread: render interleaved stereo frames into out
+void SynthEngine::render(float* out, unsigned long frames) {
+    publishClock(frames);
+
+    // Read the latest parameter snapshot (wait-free, never blocks on the UI thread)
+    const SynthParams& snapshot = params->read();
+
+    // Take a new note tuning, if one was published, before this block's notes start
+    if (const Tuning::NoteTable* table = tunings.take()) {
+        voices.setNoteFrequencies(*table);
+    }
+
+    // Update envelope and polyphony parameters
+    voices.setAttack(snapshot.attack);
+    voices.setDecay(snapshot.decay);
+    voices.setSustain(snapshot.sustain);
+    voices.setRelease(snapshot.release);
+    voices.setEnvelopeCurve(static_cast<Envelope::Curve>(snapshot.envelope_curve));
+    voices.setVoiceCount(snapshot.voice_count);
+    voices.setStealPolicy(static_cast<VoiceStealPolicy>(snapshot.voice_steal_policy));
+
+    // Apply filter parameters; a newly selected model starts from a clear state
+    // rather than from whatever it held when it was last used
+    applyFilterParams(filter, snapshot);
+    applyFilterParams(filterRight, snapshot);
+    ladder.setDrive(snapshot.filter_drive);
+    ladder.setOversampling(snapshot.filter_oversampling);
+    ladder.setAutoVariationFrequency(snapshot.filter_auto_variation_frequency);
+    ladder.setAutoVariationAmount(snapshot.filter_auto_variation_amount);
+    auto type = static_cast<FilterType>(snapshot.filter_type);
+    if (type != filterType) {
+        filterType = type;
+        for (FilterChannel* channel : { &filter, &filterRight }) {
+            channel->biquad.reset();
+            channel->svf.reset();
+        }
+        ladder.reset();
+    }
+
+    // Volume, cutoff and resonance glide to the snapshot's values rather than jumping
+    // at the block edge; the very first block starts on them
+    volume.setTarget(snapshot.volume);
+    cutoff.setTarget(snapshot.filter_cutoff);
+    resonance.setTarget(snapshot.filter_resonance);
+    if (frameCount == 0) {
+        volume.setImmediate(snapshot.volume);
+        cutoff.setImmediate(snapshot.filter_cutoff);
+        resonance.setImmediate(snapshot.filter_resonance);
+        applyFilterTone();
+    }
+
+    // Render in fixed-size sub-blocks on a grid of RENDER_BLOCK_SIZE frames whatever
+    // the host asks for, and split further at each event's frame so changes land
+    // sample-accurately
+    unsigned long done = 0;
+    while (done < frames) {
+        const SynthEvent* next = events.front();
+        while (next && next->frame <= frameCount) {
+            applyEvent(*next);
+            events.popFront();
+            next = events.front();
+        }
+
+        auto gridLeft = static_cast<unsigned long>(SynthConstants::RENDER_BLOCK_SIZE
+                                                   - frameCount % SynthConstants::RENDER_BLOCK_SIZE);
+        unsigned long segment = std::min<unsigned long>(frames - done, gridLeft);
+        if (next && next->frame < frameCount + segment) {
+            segment = static_cast<unsigned long>(next->frame - frameCount);
+        }
+
+        renderSegment(out + done * 2, segment);
+        done += segment;
+        frameCount += segment;
+    }
+}
+
+// Render at most RENDER_BLOCK_SIZE frames with no event in between
+void SynthEngine::renderSegment(float* out, unsigned long frames) {
+    // Cutoff and resonance glide in one step per grid block: fine enough not to zipper,
+    // and the filter coefficients are only recomputed while one of them is moving
+    bool gridStart = frameCount % SynthConstants::RENDER_BLOCK_SIZE == 0;
+    if (gridStart && (cutoff.isSmoothing() || resonance.isSmoothing())) {
+        cutoff.advance(SynthConstants::RENDER_BLOCK_SIZE);
+        resonance.advance(SynthConstants::RENDER_BLOCK_SIZE);
+        applyFilterTone();
+    }
+
+    // Idle: no voice sounding and the filter tail has rung out, so the whole chain would
+    // give silence. Skip it; the filters only keep their LFO moving
+    // Decided once per grid block, after freeing finished voices, so the skipped frames
+    // (and the output) do not depend on the host buffer size; a note starting inside the
+    // block ends the skip
+    if (gridStart) {
+        voices.retireFinishedVoices();
+        chainSilent = voices.isIdle() && filtersSettled();
+    }
+    chainSilent = chainSilent && voices.isIdle();
+    if (chainSilent) {
+        skipFilters(static_cast<int>(frames));
+        volume.advance(static_cast<int>(frames));  // Same ramp position as if rendered
+        std::fill(out, out + frames * 2, 0.0f);
+        return;
+    }
+
+    // Stereo unison needs a second channel through the chain; everything else is rendered
+    // and filtered once and duplicated, with the right filter kept in step for when a
+    // spread stack starts. Volume is smoothed per sample (a constant fill once settled)
+    volume.fill(gains, static_cast<int>(frames));
+    if (voices.isStereo()) {
+        voices.processBuffer(buffer, bufferRight, static_cast<int>(frames));
+        runFilters(buffer, bufferRight, static_cast<int>(frames));
+
+        for (unsigned long i = 0; i < frames; i++) {
+            out[i * 2] = buffer[i] * gains[i];
+            out[i * 2 + 1] = bufferRight[i] * gains[i];
+        }
+        return;
+    }
+
+    // Render and mix every sounding voice
+    voices.processBuffer(buffer, static_cast<int>(frames));
+
+    // Apply filter
+    runFilters(buffer, nullptr, static_cast<int>(frames));
+
+    // Process each sample through the rest of the chain
+    for (unsigned long i = 0; i < frames; i++) {
+        float sample = buffer[i];
+
+        // Apply volume control
+        sample = sample * gains[i];
+
+        // Convert to stereo (duplicate mono to both channels)
+        out[i * 2] = sample;     // Left channel
+        out[i * 2 + 1] = sample; // Right channel
+    }
+}
+
+// Pass the snapshot's unsmoothed filter settings to every model of a channel
+// Unchanged values return early in the setters, so the idle model costs nothing
+void SynthEngine::applyFilterParams(FilterChannel& channel, const SynthParams& snapshot) {
+    channel.biquad.setAutoVariationFrequency(snapshot.filter_auto_variation_frequency);
+    channel.biquad.setAutoVariationAmount(snapshot.filter_auto_variation_amount);
+    channel.svf.setMode(static_cast<StateVariableFilter::Mode>(snapshot.filter_mode));
+    channel.svf.setAutoVariationFrequency(snapshot.filter_auto_variation_frequency);
+    channel.svf.setAutoVariationAmount(snapshot.filter_auto_variation_amount);
+}
+
+// Pass the smoothed cutoff and resonance to every filter model
+// Every model follows them, so switching models never lands on stale values
+void SynthEngine::applyFilterTone() {
+    for (FilterChannel* channel : { &filter, &filterRight }) {
+        channel->biquad.setCutoff(cutoff.getCurrent());
+        channel->biquad.setResonance(resonance.getCurrent());
+        channel->svf.setCutoff(cutoff.getCurrent());
+        channel->svf.setResonance(resonance.getCurrent());
+    }
+    ladder.setCutoff(cutoff.getCurrent());
+    ladder.setResonance(resonance.getCurrent());
+}
+
+// Run the selected filter model over a sub-block in place
+// A mono mix passes a null right channel: its filter is then kept in step with the left
+void SynthEngine::runFilters(float* left, float* right, int count) {
+    switch (filterType) {
+        case FilterType::Biquad:
+            filter.biquad.processBlock(left, count);
+            if (right) filterRight.biquad.processBlock(right, count);
+            else filterRight.biquad = filter.biquad;
+            break;
+        case FilterType::StateVariable:
+            filter.svf.processBlock(left, count);
+            if (right) filterRight.svf.processBlock(right, count);
+            else filterRight.svf = filter.svf;
+            break;
+        case FilterType::Ladder: {
+            // Both channels in one pass: lanes 0 and 1 of the bank
+            float* channels[] = { left, right };
+            ladder.processBlock(channels, right ? 2 : 1, count);
+            if (!right) ladder.copyLane(0, 1);
+            break;
+        }
+    }
+}
+
+// True once the selected filter model has rung out on both channels
+bool SynthEngine::filtersSettled() const {
+    switch (filterType) {
+        case FilterType::Biquad:
+            return filter.biquad.isSettled() && filterRight.biquad.isSettled();
+        case FilterType::StateVariable:
+            return filter.svf.isSettled() && filterRight.svf.isSettled();
+        case FilterType::Ladder:
+            return ladder.isSettled();
+    }
+    return true;
+}
+
+// Stand-in for runFilters() over silence once settled
+// Both channels end up settled with the same LFO state, so the right one is a copy of the left
+void SynthEngine::skipFilters(int frames) {
+    switch (filterType) {
+        case FilterType::Biquad:
+            filter.biquad.skipSilence(frames);
+            filterRight.biquad = filter.biquad;
+            break;
+        case FilterType::StateVariable:
+            filter.svf.skipSilence(frames);
+            filterRight.svf = filter.svf;
+            break;
+        case FilterType::Ladder:
+            ladder.skipSilence(frames);
+            break;
+    }
+}
@@ -0,0 +1,25 @@
+#include "include/SynthParamsBuffer.h"
+
+// Constructor: all three slots start with default parameters
+SynthParamsBuffer::SynthParamsBuffer()
+    : shared(1),
+      writeIndex(0),
+      readIndex(2) {}
+
+// Writer side: publish a complete parameter snapshot
+void SynthParamsBuffer::publish(const SynthParams& params) {
+    slots[writeIndex] = params;
+    // Hand the filled slot over and take back whichever slot was shared
+    uint8_t previous = shared.exchange(writeIndex | FRESH_BIT, std::memory_order_acq_rel);
+    writeIndex = previous & INDEX_MASK;
+}
+
+// Reader side: return the most recently published snapshot
+const SynthParams& SynthParamsBuffer::read() {
+    if (shared.load(std::memory_order_relaxed) & FRESH_BIT) {
+        // Take the fresh slot and leave our old one for the writer to reuse
+        uint8_t previous = shared.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+    }
+    return slots[readIndex];
+}
@@ -1,9 +1,58 @@
 #include "include/TripleOscillator.h"
+#include <algorithm>
 
-// Constructor
-TripleOscillator::TripleOscillator() {
-    std::lock_guard<std::mutex> lock(mutex);
+namespace {
+
+// Largest phase deviation, in cycles, that modulation can reach
+constexpr float MAX_MODULATION_CYCLES = 127.0f;
+
+// Modulator depth in cycles per unit of output for a modulation index in radians
+// (oscillators peak at BASE_AMPLITUDE, so that level gives the full index)
+float modulationDepth(float index) {
+    index = std::clamp(index, 0.0f, SynthConstants::MAX_MODULATION_INDEX);
+    return index / static_cast<float>(SynthConstants::TWO_PI * SynthConstants::BASE_AMPLITUDE);
+}
+
+// Phase offsets (2^32 = one cycle) for a carrier, from the deviation in cycles.
+// Converted through 24-bit fixed point so the loop is plain float to int32
+// conversions and shifts, and vectorizes; the clamp keeps the conversion in range
+void phaseOffsets(const float* cycles, uint32_t* offsets, int count) {
+    for (int i = 0; i < count; i++) {
+        float clamped = std::min(std::max(cycles[i], -MAX_MODULATION_CYCLES), MAX_MODULATION_CYCLES);
+        offsets[i] = static_cast<uint32_t>(static_cast<int32_t>(clamped * 16777216.0f)) << 8;
+    }
+}
+
+// Render one oscillator in mono or stereo
+template <bool Stereo>
+void renderOscillator(Oscillator& osc, float* left, float* right, int count, const uint32_t* modulation) {
+    if constexpr (Stereo) osc.processBuffer(left, right, count, modulation);
+    else osc.processBuffer(left, count, modulation);
+}
 
+// Add a heard oscillator to the output if it is enabled; the first one is rendered
+// straight into the output (silent = nothing written yet)
+template <bool Stereo>
+void mixOscillator(Oscillator& osc, bool& silent, float* left, float* right, int count, const uint32_t* modulation) {
+    if (!osc.getEnabled()) return;
+    if (silent) {
+        renderOscillator<Stereo>(osc, left, right, count, modulation);
+        silent = false;
+        return;
+    }
+    alignas(32) float tempLeft[SynthConstants::RENDER_BLOCK_SIZE];
+    alignas(32) float tempRight[SynthConstants::RENDER_BLOCK_SIZE];
+    renderOscillator<Stereo>(osc, tempLeft, tempRight, count, modulation);
+    for (int i = 0; i < count; i++) left[i] += tempLeft[i];
+    if constexpr (Stereo) {
+        for (int i = 0; i < count; i++) right[i] += tempRight[i];
+    }
+}
+
+} // namespace
+
+// Constructor
+TripleOscillator::TripleOscillator() : algorithm(Algorithm::Mix), modDepth2(0.0f), modDepth3(0.0f) {
     // Set default waveforms
     osc1.setWaveform(Oscillator::Waveform::Triangle);  // Default: Triangle
     osc2.setWaveform(Oscillator::Waveform::Saw);       // Default: Saw
@@ -13,116 +62,312 @@ TripleOscillator::TripleOscillator() {
     osc1.setEnabled(true);
     osc2.setEnabled(false);
     osc3.setEnabled(false);
+
+    // Give each oscillator its own noise stream
+    setSeed(SynthConstants::DEFAULT_NOISE_SEED);
 }
 
 // Set base frequency for all oscillators
 void TripleOscillator::setFrequency(double freq) {
-    std::lock_guard<std::mutex> lock(mutex);
     osc1.setFrequency(freq);
     osc2.setFrequency(freq);
     osc3.setFrequency(freq);
 }
 
+// Same, as a phase increment per sample (2^32 = one cycle)
+void TripleOscillator::setPhaseIncrement(double increment) {
+    osc1.setPhaseIncrement(increment);
+    osc2.setPhaseIncrement(increment);
+    osc3.setPhaseIncrement(increment);
+}
+
 // Enable/disable first oscillator
 void TripleOscillator::setOsc1Enabled(bool enabled) { 
-    std::lock_guard<std::mutex> lock(mutex);
     osc1.setEnabled(enabled); 
 }
 
 // Enable/disable second oscillator
 void TripleOscillator::setOsc2Enabled(bool enabled) { 
-    std::lock_guard<std::mutex> lock(mutex);
     osc2.setEnabled(enabled); 
 }
 
 // Enable/disable third oscillator
 void TripleOscillator::setOsc3Enabled(bool enabled) { 
-    std::lock_guard<std::mutex> lock(mutex);
     osc3.setEnabled(enabled); 
 }
 
 // Set waveform of first oscillator
 void TripleOscillator::setOsc1Waveform(Oscillator::Waveform wf) { 
-    std::lock_guard<std::mutex> lock(mutex);
     osc1.setWaveform(wf); 
 }
 
 // Set waveform of second oscillator
 void TripleOscillator::setOsc2Waveform(Oscillator::Waveform wf) { 
-    std::lock_guard<std::mutex> lock(mutex);
     osc2.setWaveform(wf); 
 }
 
 // Set waveform of third oscillator
 void TripleOscillator::setOsc3Waveform(Oscillator::Waveform wf) { 
-    std::lock_guard<std::mutex> lock(mutex);
     osc3.setWaveform(wf); 
 }
 
 // Set frequency offset for first oscillator
 void TripleOscillator::setOsc1FrequencyOffset(float offset) { 
-    std::lock_guard<std::mutex> lock(mutex);
     osc1.setFrequencyOffset(offset); 
 }
 
 // Set frequency offset for second oscillator
 void TripleOscillator::setOsc2FrequencyOffset(float offset) { 
-    std::lock_guard<std::mutex> lock(mutex);
     osc2.setFrequencyOffset(offset); 
 }
 
 // Set frequency offset for third oscillator
 void TripleOscillator::setOsc3FrequencyOffset(float offset) { 
-    std::lock_guard<std::mutex> lock(mutex);
     osc3.setFrequencyOffset(offset); 
 }
 
+// Set unison stack size of first oscillator
+void TripleOscillator::setOsc1Unison(int count) {
+    osc1.setUnison(count);
+}
+
+// Set unison stack size of second oscillator
+void TripleOscillator::setOsc2Unison(int count) {
+    osc2.setUnison(count);
+}
+
+// Set unison stack size of third oscillator
+void TripleOscillator::setOsc3Unison(int count) {
+    osc3.setUnison(count);
+}
+
+// Set unison detune of first oscillator
+void TripleOscillator::setOsc1UnisonDetune(float cents) {
+    osc1.setUnisonDetune(cents);
+}
+
+// Set unison detune of second oscillator
+void TripleOscillator::setOsc2UnisonDetune(float cents) {
+    osc2.setUnisonDetune(cents);
+}
+
+// Set unison detune of third oscillator
+void TripleOscillator::setOsc3UnisonDetune(float cents) {
+    osc3.setUnisonDetune(cents);
+}
+
+// Set unison stereo spread of first oscillator
+void TripleOscillator::setOsc1UnisonSpread(float spread) {
+    osc1.setUnisonSpread(spread);
+}
+
+// Set unison stereo spread of second oscillator
+void TripleOscillator::setOsc2UnisonSpread(float spread) {
+    osc2.setUnisonSpread(spread);
+}
+
+// Set unison stereo spread of third oscillator
+void TripleOscillator::setOsc3UnisonSpread(float spread) {
+    osc3.setUnisonSpread(spread);
+}
+
+// Choose how the oscillators combine
+void TripleOscillator::setAlgorithm(Algorithm newAlgorithm) {
+    algorithm = newAlgorithm;
+}
+
+// Modulation index of the osc2 link, in radians
+void TripleOscillator::setOsc2ModIndex(float index) {
+    modDepth2 = modulationDepth(index);
+}
+
+// Modulation index of the osc3 link, in radians
+void TripleOscillator::setOsc3ModIndex(float index) {
+    modDepth3 = modulationDepth(index);
+}
+
+// True when a heard oscillator spreads a unison stack across the stereo field
+bool TripleOscillator::isStereo() const {
+    switch (algorithm) {
+        case Algorithm::Stack:
+        case Algorithm::Dual:
+            return osc1.isStereo();
+        case Algorithm::Split:
+            return osc1.isStereo() || osc3.isStereo();
+        default:
+            return osc1.isStereo() || osc2.isStereo() || osc3.isStereo();
+    }
+}
+
 // Set attack time for the envelope
 void TripleOscillator::setAttack(float a) {
-    std::lock_guard<std::mutex> lock(mutex);
     env.setAttack(a); 
 }
 
+// Set decay time for the envelope
+void TripleOscillator::setDecay(float d) {
+    env.setDecay(d);
+}
+
+// Set sustain level for the envelope
+void TripleOscillator::setSustain(float s) {
+    env.setSustain(s);
+}
+
 // Set release time for the envelope
 void TripleOscillator::setRelease(float r) {
-    std::lock_guard<std::mutex> lock(mutex);
     env.setRelease(r); 
 }
 
+// Set the envelope's segment shape
+void TripleOscillator::setEnvelopeCurve(Envelope::Curve curve) {
+    env.setCurve(curve);
+}
+
 // Trigger note-on for the envelope
 void TripleOscillator::noteOn() { 
-    std::lock_guard<std::mutex> lock(mutex);
     env.noteOn(); 
 }
 
 // Trigger note-off for the envelope
 void TripleOscillator::noteOff() { 
-    std::lock_guard<std::mutex> lock(mutex);
     env.noteOff(); 
 }
 
-// Set sample rate for the envelope
-void TripleOscillator::setEnvSampleRate(float sr) {
-    std::lock_guard<std::mutex> lock(mutex);
-    env.setSampleRate(sr); 
+// Current envelope amplitude
+float TripleOscillator::getLevel() const {
+    return env.getLevel();
+}
+
+// True while the note is held or still releasing
+bool TripleOscillator::isActive() const {
+    return env.isActive();
+}
+
+// Set sample rate for all oscillators and the envelope
+void TripleOscillator::setSampleRate(double sr) {
+    osc1.setSampleRate(sr);
+    osc2.setSampleRate(sr);
+    osc3.setSampleRate(sr);
+    env.setSampleRate(static_cast<float>(sr));
+}
+
+// Seed the noise generators (each oscillator gets its own stream)
+void TripleOscillator::setSeed(uint32_t seed) {
+    osc1.setSeed(seed);
+    osc2.setSeed(seed + 1);
+    osc3.setSeed(seed + 2);
 }
 
 // Process a buffer of samples (size = bufferSize), combining all oscillators and applying the envelope
 void TripleOscillator::processBuffer(float* buffer, int bufferSize) {
-    std::lock_guard<std::mutex> lock(mutex);
-    float tempBuffer1[bufferSize]; // Temp buffer for osc1
-    float tempBuffer2[bufferSize]; // Temp buffer for osc2
-    float tempBuffer3[bufferSize]; // Temp buffer for osc3
+    alignas(32) float mix[SynthConstants::RENDER_BLOCK_SIZE]; // Oscillator output before the envelope
+    alignas(32) float gains[SynthConstants::RENDER_BLOCK_SIZE]; // Master envelope, one value per sample
+
+    for (int start = 0; start < bufferSize; start += SynthConstants::RENDER_BLOCK_SIZE) {
+        int count = std::min(bufferSize - start, SynthConstants::RENDER_BLOCK_SIZE);
+
+        renderOscillators<false>(mix, nullptr, count);
+
+        // Apply the master amplitude envelope
+        env.processBlock(gains, count);
+        for(int i = 0; i < count; i++) {
+            buffer[start + i] = mix[i] * gains[i];
+        }
+    }
+}
+
+// Same, rendering left and right channels with one envelope value per frame
+void TripleOscillator::processBuffer(float* left, float* right, int bufferSize) {
+    alignas(32) float mixLeft[SynthConstants::RENDER_BLOCK_SIZE];
+    alignas(32) float mixRight[SynthConstants::RENDER_BLOCK_SIZE];
+    alignas(32) float gains[SynthConstants::RENDER_BLOCK_SIZE];
 
-    // Process all oscillators into their respective buffers
-    osc1.processBuffer(tempBuffer1, bufferSize);
-    osc2.processBuffer(tempBuffer2, bufferSize);
-    osc3.processBuffer(tempBuffer3, bufferSize);
+    for (int start = 0; start < bufferSize; start += SynthConstants::RENDER_BLOCK_SIZE) {
+        int count = std::min(bufferSize - start, SynthConstants::RENDER_BLOCK_SIZE);
 
-    // Mix the three oscillators and apply the master amplitude envelope
-    for(int i = 0; i < bufferSize; i++) {
-        float envValue = env.process(); // Get master envelope value for this sample
+        renderOscillators<true>(mixLeft, mixRight, count);
+
+        env.processBlock(gains, count);
+        for (int i = 0; i < count; i++) {
+            left[start + i] = mixLeft[i] * gains[i];
+            right[start + i] = mixRight[i] * gains[i];
+        }
+    }
+}
+
+// Render the current algorithm's output for one sub-block, before the envelope
+// Only enabled oscillators are rendered: the first heard one goes straight into the
+// output and the rest are added to it, so a disabled oscillator costs nothing.
+// Modulators always render mono; their output becomes per-sample phase offsets
+// that the carrier's kernel adds to its read position, a block at a time
+template <bool Stereo>
+void TripleOscillator::renderOscillators(float* left, float* right, int count) {
+    alignas(32) float left2[SynthConstants::RENDER_BLOCK_SIZE];
+    alignas(32) float left3[SynthConstants::RENDER_BLOCK_SIZE];
+    alignas(32) float cycles[SynthConstants::RENDER_BLOCK_SIZE];
+    alignas(32) uint32_t modulation[SynthConstants::RENDER_BLOCK_SIZE];
+    const uint32_t* carrierModulation = nullptr;
+    bool silent = true;
+
+    switch (algorithm) {
+        case Algorithm::Stack:
+            if (!osc1.getEnabled()) break;  // Modulators of a silent carrier are not heard
+            if (osc2.getEnabled()) {
+                const uint32_t* osc2Modulation = nullptr;
+                if (osc3.getEnabled()) {
+                    osc3.processBuffer(left3, count);
+                    for (int i = 0; i < count; i++) cycles[i] = left3[i] * modDepth3;
+                    phaseOffsets(cycles, modulation, count);
+                    osc2Modulation = modulation;
+                }
+                osc2.processBuffer(left2, count, osc2Modulation);
+                for (int i = 0; i < count; i++) cycles[i] = left2[i] * modDepth2;
+                phaseOffsets(cycles, modulation, count);
+                carrierModulation = modulation;
+            }
+            mixOscillator<Stereo>(osc1, silent, left, right, count, carrierModulation);
+            break;
+
+        case Algorithm::Dual:
+            if (!osc1.getEnabled()) break;
+            if (osc2.getEnabled() && osc3.getEnabled()) {
+                osc2.processBuffer(left2, count);
+                osc3.processBuffer(left3, count);
+                for (int i = 0; i < count; i++) cycles[i] = left2[i] * modDepth2 + left3[i] * modDepth3;
+                phaseOffsets(cycles, modulation, count);
+                carrierModulation = modulation;
+            } else if (osc2.getEnabled() || osc3.getEnabled()) {
+                Oscillator& modulator = osc2.getEnabled() ? osc2 : osc3;
+                float depth = osc2.getEnabled() ? modDepth2 : modDepth3;
+                modulator.processBuffer(left2, count);
+                for (int i = 0; i < count; i++) cycles[i] = left2[i] * depth;
+                phaseOffsets(cycles, modulation, count);
+                carrierModulation = modulation;
+            }
+            mixOscillator<Stereo>(osc1, silent, left, right, count, carrierModulation);
+            break;
+
+        case Algorithm::Split:
+            if (osc1.getEnabled() && osc2.getEnabled()) {
+                osc2.processBuffer(left2, count);
+                for (int i = 0; i < count; i++) cycles[i] = left2[i] * modDepth2;
+                phaseOffsets(cycles, modulation, count);
+                carrierModulation = modulation;
+            }
+            mixOscillator<Stereo>(osc1, silent, left, right, count, carrierModulation);
+            mixOscillator<Stereo>(osc3, silent, left, right, count, nullptr);
+            break;
+
+        default:
+            mixOscillator<Stereo>(osc1, silent, left, right, count, nullptr);
+            mixOscillator<Stereo>(osc2, silent, left, right, count, nullptr);
+            mixOscillator<Stereo>(osc3, silent, left, right, count, nullptr);
+            break;
+    }
 
-        buffer[i] = (tempBuffer1[i] + tempBuffer2[i] + tempBuffer3[i]) * envValue;
+    if (silent) {
+        std::fill(left, left + count, 0.0f);
+        if constexpr (Stereo) std::fill(right, right + count, 0.0f);
     }
 }
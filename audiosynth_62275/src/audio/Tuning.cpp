@@ -0,0 +1,264 @@
+#include "include/Tuning.h"
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+// Notes above the Nyquist frequency of the highest supported sample rate stay silent
+// (at lower rates the voice pool also silences those above that rate's Nyquist frequency)
+constexpr double MAX_FREQUENCY = 96000.0;
+
+// One line of a Scala file, with its number for error messages
+struct ScalaLine {
+    int number;
+    std::string text;
+};
+
+// Read a Scala file without its '!' comment lines; returns false if it cannot be opened
+bool readScalaLines(const std::string& path, std::vector<ScalaLine>& lines) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    std::string line;
+    int number = 0;
+    while (std::getline(file, line)) {
+        number++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty() && line[0] == '!') continue;
+        lines.push_back({ number, line });
+    }
+    return true;
+}
+
+// First whitespace-separated token of a line, empty for a blank line
+std::string firstToken(const std::string& line) {
+    std::istringstream in(line);
+    std::string token;
+    in >> token;
+    return token;
+}
+
+// Parse a whole token as an integer
+bool parseInt(const std::string& token, long& value) {
+    char* end = nullptr;
+    value = std::strtol(token.c_str(), &end, 10);
+    return !token.empty() && *end == '\0';
+}
+
+// Parse a whole token as a number
+bool parseDouble(const std::string& token, double& value) {
+    char* end = nullptr;
+    value = std::strtod(token.c_str(), &end);
+    return !token.empty() && *end == '\0' && std::isfinite(value);
+}
+
+// Parse a scale pitch: cents if it has a '.', otherwise a ratio "n/d" or a whole number "n"
+bool parsePitch(const std::string& token, double& cents) {
+    if (token.find('.') != std::string::npos) {
+        return parseDouble(token, cents);
+    }
+    size_t slash = token.find('/');
+    long numerator = 0;
+    long denominator = 1;
+    if (!parseInt(token.substr(0, slash), numerator)
+        || (slash != std::string::npos && !parseInt(token.substr(slash + 1), denominator))
+        || numerator <= 0 || denominator <= 0) {
+        return false;
+    }
+    cents = 1200.0 * std::log2(static_cast<double>(numerator) / static_cast<double>(denominator));
+    return true;
+}
+
+// Round towards negative infinity, so negative notes fall in the pattern below
+int floorDiv(int a, int b) {
+    int q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+} // namespace
+
+// Constructor: 12-tone equal temperament, A4 = 440 Hz
+Tuning::Tuning() {
+    reset();
+}
+
+// Load a Scala scale (.scl); returns false and describes the problem in error
+// Format: a description line, the number of degrees, then one pitch per degree
+bool Tuning::loadScale(const std::string& path, std::string& error) {
+    std::vector<ScalaLine> lines;
+    if (!readScalaLines(path, lines)) {
+        error = "cannot open scale file " + path;
+        return false;
+    }
+
+    // The first line is the description (possibly blank), the rest may have blank lines
+    std::vector<ScalaLine> values;
+    for (size_t i = 1; i < lines.size(); i++) {
+        if (!firstToken(lines[i].text).empty()) values.push_back(lines[i]);
+    }
+
+    long count = 0;
+    if (lines.empty() || values.empty() || !parseInt(firstToken(values[0].text), count) || count < 1) {
+        int number = values.empty() ? 0 : values[0].number;
+        error = path + ":" + std::to_string(number) + ": expected the number of scale degrees";
+        return false;
+    }
+    if (static_cast<long>(values.size()) - 1 < count) {
+        error = path + ": scale has " + std::to_string(values.size() - 1) + " of "
+                + std::to_string(count) + " degrees";
+        return false;
+    }
+
+    std::vector<double> degrees;
+    for (long k = 1; k <= count; k++) {
+        double cents = 0.0;
+        if (!parsePitch(firstToken(values[k].text), cents)) {
+            error = path + ":" + std::to_string(values[k].number) + ": expected cents (with a '.') or a ratio";
+            return false;
+        }
+        degrees.push_back(cents);
+    }
+    if (degrees.back() <= 0.0) {
+        error = path + ": the last degree (the period) must be above 1/1";
+        return false;
+    }
+
+    scale = degrees;
+    rebuild();
+    return true;
+}
+
+// Load a Scala keyboard mapping (.kbm); returns false and describes the problem in error
+// Format: pattern size, first note, last note, middle note, reference note, reference
+// frequency, formal octave degree, then one degree (or 'x' for silent) per pattern key
+bool Tuning::loadKeyboardMapping(const std::string& path, std::string& error) {
+    std::vector<ScalaLine> lines;
+    if (!readScalaLines(path, lines)) {
+        error = "cannot open keyboard mapping " + path;
+        return false;
+    }
+    std::vector<ScalaLine> values;
+    for (const ScalaLine& line : lines) {
+        if (!firstToken(line.text).empty()) values.push_back(line);
+    }
+
+    static const char* const HEADER[] = { "pattern size", "first note", "last note", "middle note",
+                                          "reference note", "reference frequency", "formal octave degree" };
+    long header[7] = {};
+    double frequency = 0.0;
+    for (int i = 0; i < 7; i++) {
+        std::string token = i < static_cast<int>(values.size()) ? firstToken(values[i].text) : "";
+        bool valid = i == 5 ? parseDouble(token, frequency) && frequency > 0.0
+                            : parseInt(token, header[i]) && header[i] >= 0
+                              && (i == 0 || i == 6 || header[i] < NOTE_COUNT);
+        if (!valid) {
+            int number = i < static_cast<int>(values.size()) ? values[i].number : 0;
+            error = path + ":" + std::to_string(number) + ": invalid " + HEADER[i];
+            return false;
+        }
+    }
+    if (header[1] > header[2]) {
+        error = path + ": first note is above the last note";
+        return false;
+    }
+
+    // Keys missing at the end of the pattern are silent
+    std::vector<int> keys(static_cast<size_t>(header[0]), -1);
+    for (size_t k = 0; k < keys.size() && 7 + k < values.size(); k++) {
+        std::string token = firstToken(values[7 + k].text);
+        long degree = 0;
+        if (token == "x" || token == "X") continue;
+        if (!parseInt(token, degree) || degree < 0) {
+            error = path + ":" + std::to_string(values[7 + k].number) + ": expected a scale degree or 'x'";
+            return false;
+        }
+        keys[k] = static_cast<int>(degree);
+    }
+
+    Tuning next = *this;
+    next.mapping = keys;
+    next.firstNote = static_cast<int>(header[1]);
+    next.lastNote = static_cast<int>(header[2]);
+    next.middleNote = static_cast<int>(header[3]);
+    next.referenceNote = static_cast<int>(header[4]);
+    next.referenceFrequency = frequency;
+    next.octaveDegree = static_cast<int>(header[6]);
+    double cents = 0.0;
+    if (!next.noteCents(next.referenceNote, cents)) {
+        error = path + ": the reference note is not mapped to a scale degree";
+        return false;
+    }
+
+    next.rebuild();
+    *this = next;
+    return true;
+}
+
+// Back to 12-tone equal temperament with the default mapping
+void Tuning::reset() {
+    scale.clear();
+    for (int k = 1; k <= 12; k++) {
+        scale.push_back(100.0 * k);
+    }
+    mapping.clear();
+    firstNote = 0;
+    lastNote = NOTE_COUNT - 1;
+    middleNote = 60;
+    referenceNote = 69;
+    referenceFrequency = 440.0;
+    octaveDegree = 0;
+    rebuild();
+}
+
+// Frequency of a MIDI note in Hz, 0 for notes the mapping leaves silent
+double Tuning::frequency(int note) const {
+    return note >= 0 && note < NOTE_COUNT ? frequencies[note] : 0.0;
+}
+
+// Frequency of every MIDI note, as frequency() gives them
+const Tuning::NoteTable& Tuning::noteTable() const {
+    return frequencies;
+}
+
+// Pitch of a scale degree in cents above degree 0, repeating every period
+double Tuning::degreeCents(int degree) const {
+    int size = static_cast<int>(scale.size());
+    int periods = floorDiv(degree, size);
+    int step = degree - periods * size;
+    return periods * scale.back() + (step > 0 ? scale[step - 1] : 0.0);
+}
+
+// Pitch of a note in cents above the middle note, false if the note is unmapped
+bool Tuning::noteCents(int note, double& cents) const {
+    int offset = note - middleNote;
+    if (mapping.empty()) {
+        cents = degreeCents(offset);
+        return true;
+    }
+    int size = static_cast<int>(mapping.size());
+    int patterns = floorDiv(offset, size);
+    int degree = mapping[offset - patterns * size];
+    if (degree < 0) {
+        return false;
+    }
+    double octave = octaveDegree > 0 ? degreeCents(octaveDegree) : scale.back();
+    cents = patterns * octave + degreeCents(degree);
+    return true;
+}
+
+// Recompute the note table from the scale and the mapping
+void Tuning::rebuild() {
+    double referenceCents = 0.0;
+    noteCents(referenceNote, referenceCents);
+    for (int note = 0; note < NOTE_COUNT; note++) {
+        double cents = 0.0;
+        double f = 0.0;
+        if (note >= firstNote && note <= lastNote && noteCents(note, cents)) {
+            f = referenceFrequency * std::exp2((cents - referenceCents) / 1200.0);
+        }
+        frequencies[note] = std::isfinite(f) && f <= MAX_FREQUENCY ? f : 0.0;
+    }
+}
@@ -0,0 +1,320 @@
+#include "include/VoicePool.h"
+#include <algorithm>
+
+// Constructor: all voices idle, full pool in use, oldest-voice stealing
+VoicePool::VoicePool()
+    : voiceCount(MAX),
+      renderCount(MAX),
+      stealPolicy(VoiceStealPolicy::Oldest),
+      allocationCounter(0),
+      sampleRate(SynthConstants::DEFAULT_SAMPLE_RATE) {
+    notes.fill(-1);
+    startedAt.fill(0);
+    levels.fill(0.0f);
+    gates.fill(0);
+    active.fill(0);
+    setSeed(SynthConstants::DEFAULT_NOISE_SEED);
+    setNoteFrequencies(Tuning().noteTable());
+}
+
+// Number of voices available for allocation (1 to MAX_VOICES)
+void VoicePool::setVoiceCount(int count) {
+    count = std::clamp(count, 1, MAX);
+    // Voices that fall outside the pool are released, not cut off (which would click):
+    // they keep rendering until their envelope finishes, but take no new notes
+    for (int v = count; v < voiceCount; v++) {
+        if (gates[v]) {
+            voices[v].noteOff();
+            gates[v] = 0;
+        }
+    }
+    voiceCount = count;
+    renderCount = std::max(renderCount, count);
+}
+
+int VoicePool::getVoiceCount() const {
+    return voiceCount;
+}
+
+// Choose how voices are stolen when the pool is full
+void VoicePool::setStealPolicy(VoiceStealPolicy policy) {
+    stealPolicy = policy;
+}
+
+// Pick the voice for a new note: same note, then idle voice, then steal
+int VoicePool::allocate(int note) const {
+    if (stealPolicy == VoiceStealPolicy::SameNote) {
+        for (int v = 0; v < voiceCount; v++) {
+            if (active[v] && notes[v] == note) return v;
+        }
+    }
+    for (int v = 0; v < voiceCount; v++) {
+        if (!active[v]) return v;
+    }
+
+    int victim = 0;
+    if (stealPolicy == VoiceStealPolicy::Quietest) {
+        for (int v = 1; v < voiceCount; v++) {
+            if (levels[v] < levels[victim]) victim = v;
+        }
+    } else {
+        // Oldest: released voices are stolen before held ones
+        for (int v = 1; v < voiceCount; v++) {
+            if (gates[v] < gates[victim]
+                || (gates[v] == gates[victim] && startedAt[v] < startedAt[victim])) {
+                victim = v;
+            }
+        }
+    }
+    return victim;
+}
+
+// Start a note on a free (or stolen) voice, pitched from the tuning table
+void VoicePool::noteOn(int note) {
+    if (note < 0 || note >= Tuning::NOTE_COUNT || noteIncrements[note] <= 0.0) {
+        return;
+    }
+    int v = allocate(note);
+    voices[v].setPhaseIncrement(noteIncrements[note]);
+    voices[v].noteOn();
+    notes[v] = note;
+    startedAt[v] = ++allocationCounter;
+    gates[v] = 1;
+    active[v] = 1;
+}
+
+// Release every voice playing this note
+void VoicePool::noteOff(int note) {
+    for (int v = 0; v < voiceCount; v++) {
+        if (gates[v] && notes[v] == note) {
+            voices[v].noteOff();
+            gates[v] = 0;
+        }
+    }
+}
+
+// Release every voice
+void VoicePool::allNotesOff() {
+    for (int v = 0; v < voiceCount; v++) {
+        if (gates[v]) {
+            voices[v].noteOff();
+            gates[v] = 0;
+        }
+    }
+}
+
+// Settings applied to every voice
+void VoicePool::setOscEnabled(int osc, bool enabled) {
+    for (auto& voice : voices) {
+        if (osc == 0) voice.setOsc1Enabled(enabled);
+        else if (osc == 1) voice.setOsc2Enabled(enabled);
+        else if (osc == 2) voice.setOsc3Enabled(enabled);
+    }
+}
+
+void VoicePool::setOscWaveform(int osc, Oscillator::Waveform wf) {
+    for (auto& voice : voices) {
+        if (osc == 0) voice.setOsc1Waveform(wf);
+        else if (osc == 1) voice.setOsc2Waveform(wf);
+        else if (osc == 2) voice.setOsc3Waveform(wf);
+    }
+}
+
+void VoicePool::setOscFrequencyOffset(int osc, float offset) {
+    for (auto& voice : voices) {
+        if (osc == 0) voice.setOsc1FrequencyOffset(offset);
+        else if (osc == 1) voice.setOsc2FrequencyOffset(offset);
+        else if (osc == 2) voice.setOsc3FrequencyOffset(offset);
+    }
+}
+
+void VoicePool::setOscUnison(int osc, int count) {
+    for (auto& voice : voices) {
+        if (osc == 0) voice.setOsc1Unison(count);
+        else if (osc == 1) voice.setOsc2Unison(count);
+        else if (osc == 2) voice.setOsc3Unison(count);
+    }
+}
+
+void VoicePool::setOscUnisonDetune(int osc, float cents) {
+    for (auto& voice : voices) {
+        if (osc == 0) voice.setOsc1UnisonDetune(cents);
+        else if (osc == 1) voice.setOsc2UnisonDetune(cents);
+        else if (osc == 2) voice.setOsc3UnisonDetune(cents);
+    }
+}
+
+void VoicePool::setOscUnisonSpread(int osc, float spread) {
+    for (auto& voice : voices) {
+        if (osc == 0) voice.setOsc1UnisonSpread(spread);
+        else if (osc == 1) voice.setOsc2UnisonSpread(spread);
+        else if (osc == 2) voice.setOsc3UnisonSpread(spread);
+    }
+}
+
+// Only osc2 and osc3 modulate a carrier
+void VoicePool::setOscModIndex(int osc, float index) {
+    for (auto& voice : voices) {
+        if (osc == 1) voice.setOsc2ModIndex(index);
+        else if (osc == 2) voice.setOsc3ModIndex(index);
+    }
+}
+
+void VoicePool::setAlgorithm(TripleOscillator::Algorithm algorithm) {
+    for (auto& voice : voices) {
+        voice.setAlgorithm(algorithm);
+    }
+}
+
+// Envelope settings: unchanged values return early (see the cached copies in VoicePool.h)
+void VoicePool::setAttack(float a) {
+    if (a == attack) return;
+    attack = a;
+    for (auto& voice : voices) voice.setAttack(a);
+}
+
+void VoicePool::setDecay(float d) {
+    if (d == decay) return;
+    decay = d;
+    for (auto& voice : voices) voice.setDecay(d);
+}
+
+void VoicePool::setSustain(float s) {
+    if (s == sustain) return;
+    sustain = s;
+    for (auto& voice : voices) voice.setSustain(s);
+}
+
+void VoicePool::setRelease(float r) {
+    if (r == release) return;
+    release = r;
+    for (auto& voice : voices) voice.setRelease(r);
+}
+
+void VoicePool::setEnvelopeCurve(Envelope::Curve curve) {
+    if (static_cast<int>(curve) == envelopeCurve) return;
+    envelopeCurve = static_cast<int>(curve);
+    for (auto& voice : voices) voice.setEnvelopeCurve(curve);
+}
+
+void VoicePool::setSampleRate(double sr) {
+    sampleRate = sr;
+    for (auto& voice : voices) voice.setSampleRate(sr);
+    updateNoteIncrements();
+}
+
+// Each voice gets its own noise streams (TripleOscillator uses seed, seed+1, seed+2)
+void VoicePool::setSeed(uint32_t seed) {
+    for (int v = 0; v < MAX; v++) {
+        voices[v].setSeed(seed + 3u * static_cast<uint32_t>(v));
+    }
+}
+
+// Pitch of every MIDI note; rebuilds the per-note phase increment table
+void VoicePool::setNoteFrequencies(const Tuning::NoteTable& frequencies) {
+    noteFrequencies = frequencies;
+    updateNoteIncrements();
+}
+
+// Recompute the phase increment of every note at the current sample rate
+// Notes above the Nyquist frequency would alias (and overflow the 32-bit phase step),
+// so they get no increment and noteOn() leaves them silent
+void VoicePool::updateNoteIncrements() {
+    double nyquist = sampleRate / 2.0;
+    for (int note = 0; note < Tuning::NOTE_COUNT; note++) {
+        noteIncrements[note] = noteFrequencies[note] <= nyquist
+            ? noteFrequencies[note] / sampleRate * SynthConstants::PHASE_CYCLE
+            : 0.0;
+    }
+}
+
+// Number of voices currently sounding (held or releasing)
+int VoicePool::getActiveVoiceCount() const {
+    int count = 0;
+    for (int v = 0; v < renderCount; v++) {
+        count += active[v];
+    }
+    return count;
+}
+
+// True when no voice is sounding: every envelope is idle
+bool VoicePool::isIdle() const {
+    for (int v = 0; v < renderCount; v++) {
+        if (active[v]) return false;
+    }
+    return true;
+}
+
+// Free the voices whose envelope has finished
+// Until then a finished voice still renders, as silence
+void VoicePool::retireFinishedVoices() {
+    for (int v = 0; v < renderCount; v++) {
+        if (active[v] && !voices[v].isActive()) {
+            active[v] = 0;
+        }
+    }
+    // Stop walking the voices above the pool once their release has finished
+    while (renderCount > voiceCount && !active[renderCount - 1]) {
+        renderCount--;
+    }
+}
+
+// Render and sum all sounding voices into buffer (bufferSize <= RENDER_BLOCK_SIZE)
+// The first sounding voice renders straight into the output, the rest are added to it
+void VoicePool::processBuffer(float* buffer, int bufferSize) {
+    alignas(32) float voiceBuffer[SynthConstants::RENDER_BLOCK_SIZE];
+    bool silent = true;
+
+    for (int v = 0; v < renderCount; v++) {
+        if (!active[v]) continue;  // Idle voices cost nothing
+
+        if (silent) {
+            voices[v].processBuffer(buffer, bufferSize);
+            silent = false;
+        } else {
+            voices[v].processBuffer(voiceBuffer, bufferSize);
+            for (int i = 0; i < bufferSize; i++) {
+                buffer[i] += voiceBuffer[i];
+            }
+        }
+
+        levels[v] = voices[v].getLevel();
+    }
+    if (silent) {
+        std::fill(buffer, buffer + bufferSize, 0.0f);
+    }
+}
+
+// True when the voices render different left and right channels (unison spread)
+bool VoicePool::isStereo() const {
+    return voices[0].isStereo();
+}
+
+// Same, into left and right channels
+void VoicePool::processBuffer(float* left, float* right, int bufferSize) {
+    alignas(32) float voiceLeft[SynthConstants::RENDER_BLOCK_SIZE];
+    alignas(32) float voiceRight[SynthConstants::RENDER_BLOCK_SIZE];
+    bool silent = true;
+
+    for (int v = 0; v < renderCount; v++) {
+        if (!active[v]) continue;
+
+        if (silent) {
+            voices[v].processBuffer(left, right, bufferSize);
+            silent = false;
+        } else {
+            voices[v].processBuffer(voiceLeft, voiceRight, bufferSize);
+            for (int i = 0; i < bufferSize; i++) {
+                left[i] += voiceLeft[i];
+                right[i] += voiceRight[i];
+            }
+        }
+
+        levels[v] = voices[v].getLevel();
+    }
+    if (silent) {
+        std::fill(left, left + bufferSize, 0.0f);
+        std::fill(right, right + bufferSize, 0.0f);
+    }
+}
+
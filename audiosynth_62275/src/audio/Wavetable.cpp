@@ -0,0 +1,91 @@
+#include "include/Wavetable.h"
+#include "include/SynthConstants.h"
+#include <cmath>
+
+namespace {
+
+// Duty cycle of Shape::Pulse
+constexpr double PULSE_WIDTH = 0.25;
+
+// Fourier coefficients of harmonic n for one cycle starting at phase 0
+// Matches the naive shapes: triangle 0 -> peak at 1/4, saw ramps -1 -> 1, square/pulse high first
+void harmonic(Wavetable::Shape shape, int n, double& sinCoef, double& cosCoef) {
+    sinCoef = 0.0;
+    cosCoef = 0.0;
+    switch (shape) {
+        case Wavetable::Shape::Triangle:
+            if (n % 2 == 1) sinCoef = (n % 4 == 1 ? 8.0 : -8.0) / (M_PI * M_PI * n * n);
+            break;
+        case Wavetable::Shape::Saw:
+            sinCoef = -2.0 / (M_PI * n);
+            break;
+        case Wavetable::Shape::Square:
+            if (n % 2 == 1) sinCoef = 4.0 / (M_PI * n);
+            break;
+        case Wavetable::Shape::Pulse:
+            sinCoef = 2.0 / (M_PI * n) * (1.0 - std::cos(SynthConstants::TWO_PI * n * PULSE_WIDTH));
+            cosCoef = 2.0 / (M_PI * n) * std::sin(SynthConstants::TWO_PI * n * PULSE_WIDTH);
+            break;
+        case Wavetable::Shape::Count:
+            break;
+    }
+}
+
+} // namespace
+
+// The shared bank, built on first use
+const Wavetable& Wavetable::instance() {
+    static const Wavetable bank;
+    return bank;
+}
+
+// Build every level of every shape by additive synthesis
+// Levels are filled from the fewest harmonics upwards, each one adding the octave
+// of harmonics it has over the level above; sin(2 pi n i / N) comes from one sine table
+Wavetable::Wavetable() : tables(static_cast<size_t>(Shape::Count) * LEVELS * TABLE_STRIDE, 0.0f) {
+    std::vector<double> sine(TABLE_SIZE);
+    for (int i = 0; i < TABLE_SIZE; i++) {
+        sine[i] = std::sin(SynthConstants::TWO_PI * i / TABLE_SIZE);
+    }
+
+    std::vector<double> sum(TABLE_SIZE);
+    for (int s = 0; s < static_cast<int>(Shape::Count); s++) {
+        Shape shape = static_cast<Shape>(s);
+        std::fill(sum.begin(), sum.end(), 0.0);
+        int harmonics = 0;
+        for (int level = LEVELS - 1; level >= 0; level--) {
+            int levelHarmonics = MAX_HARMONICS >> level;
+            for (int n = harmonics + 1; n <= levelHarmonics; n++) {
+                double sinCoef, cosCoef;
+                harmonic(shape, n, sinCoef, cosCoef);
+                for (int i = 0; i < TABLE_SIZE; i++) {
+                    int k = static_cast<int>((static_cast<long>(n) * i) % TABLE_SIZE);
+                    sum[i] += sinCoef * sine[k] + cosCoef * sine[(k + TABLE_SIZE / 4) % TABLE_SIZE];
+                }
+            }
+            harmonics = levelHarmonics;
+
+            float* out = table(shape, level);
+            for (int i = 0; i < TABLE_SIZE; i++) {
+                out[i] = static_cast<float>(sum[i]);
+            }
+            out[TABLE_SIZE] = out[0];
+            out[TABLE_SIZE + 1] = out[1];
+        }
+    }
+}
+
+// Start of one table: [shape][level][TABLE_STRIDE]
+float* Wavetable::table(Shape shape, int level) {
+    return tables.data() + (static_cast<size_t>(shape) * LEVELS + level) * TABLE_STRIDE;
+}
+
+// Table for a shape, band-limited for the given phase step (cycles per sample)
+// Picks the first level whose top harmonic is below Nyquist: harmonics * phaseStep < 0.5
+const float* Wavetable::select(Shape shape, double phaseStep) const {
+    int level = 0;
+    while (level < LEVELS - 1 && (MAX_HARMONICS >> level) * phaseStep >= 0.5) {
+        level++;
+    }
+    return tables.data() + (static_cast<size_t>(shape) * LEVELS + level) * TABLE_STRIDE;
+}
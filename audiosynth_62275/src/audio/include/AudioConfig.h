@@ -0,0 +1,19 @@
+#ifndef AUDIOSYNTH_AUDIOCONFIG_H
+#define AUDIOSYNTH_AUDIOCONFIG_H
+
+#include "SynthConstants.h"
+
+// Latency profiles trade callback rate (CPU wake-ups) against output latency
+enum class LatencyProfile {
+    LowLatency,  // Small buffers, device low-latency hint
+    Balanced,    // Default buffer size
+    PowerSave    // Large buffers, device high-latency hint
+};
+
+// Audio stream configuration, chosen at startup or switched live
+struct AudioConfig {
+    double sampleRate { SynthConstants::DEFAULT_SAMPLE_RATE };  // Stream and engine sample rate in Hz
+    LatencyProfile latency { LatencyProfile::Balanced };        // Buffer size / latency trade-off
+};
+
+#endif // AUDIOSYNTH_AUDIOCONFIG_H
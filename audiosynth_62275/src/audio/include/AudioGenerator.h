@@ -1,31 +1,40 @@
 #ifndef SIMPLE_SYNTH_AUDIOGENERATOR_H
 #define SIMPLE_SYNTH_AUDIOGENERATOR_H
 
+#include <deque>
 #include "portaudio.h"
-#include "TripleOscillator.h"
-#include "SynthParams.h"
-#include "Filter.h"
-
-#include <mutex>
+#include "SynthEngine.h"
+#include "SynthParamsBuffer.h"
+#include "AudioConfig.h"
 
 // AudioGenerator: manages audio stream and real-time audio processing
 // Uses PortAudio to output sound generated by the synth engine
+// Setters never lock: they post events to the engine's queue and must all be
+// called from the same control thread (the GUI thread)
 class AudioGenerator {
 public:
     // Constructor: initializes synth modules with sample rate
-    AudioGenerator(SynthParams* params);
+    AudioGenerator(SynthParamsBuffer* params);
 
     // Destructor: ensures audio stream is stopped
     ~AudioGenerator();
     
-    // Initialize audio stream
-    void init();
+    // Initialize audio stream with the given sample rate and latency profile
+    void init(const AudioConfig& config = AudioConfig());
 
     // Stop audio stream and clean up
     void stop();
 
-    // Synth parameter setters: forward calls to TripleOscillator
-    void setFrequency(double freq);
+    // Switch sample rate / latency profile live: reopens the stream
+    // Falls back to the previous configuration and returns false if the device refuses it
+    bool setAudioConfig(const AudioConfig& config);
+    const AudioConfig& getAudioConfig() const;
+
+    // Retune every MIDI note: the engine takes the new table at its next block,
+    // so the stream keeps running
+    void setTuning(const Tuning& tuning);
+
+    // Synth parameter setters: post timestamped events to the audio thread
     void setOsc1Enabled(bool enabled);
     void setOsc2Enabled(bool enabled);
     void setOsc3Enabled(bool enabled);
@@ -37,16 +46,38 @@ public:
     void setOsc2FrequencyOffset(float offset);
     void setOsc3FrequencyOffset(float offset);
 
-    void setOscSampleRate(float sr);
-    void setAttack(float a);
-    void setRelease(float r);
-    void noteOn();
-    void noteOff();
+    void setOsc1Unison(int count);
+    void setOsc2Unison(int count);
+    void setOsc3Unison(int count);
+    void setOsc1UnisonDetune(float cents);
+    void setOsc2UnisonDetune(float cents);
+    void setOsc3UnisonDetune(float cents);
+    void setOsc1UnisonSpread(float spread);
+    void setOsc2UnisonSpread(float spread);
+    void setOsc3UnisonSpread(float spread);
+
+    void setAlgorithm(TripleOscillator::Algorithm algorithm);
+    void setOsc2ModIndex(float index);
+    void setOsc3ModIndex(float index);
+
+    // Notes sound at the pitch the engine's tuning gives them
+    void noteOn(int note);
+    void noteOff(int note);
 
-    // Utility function: convert MIDI note number to frequency (Hz)
-    static double calculateNoteFrequency(int noteNumber, int octave);
+    // Retry notes held back while the event queue was full (call once per UI frame);
+    // returns true once none are left
+    bool flushPendingNotes();
+
+    // Utility function: convert keyboard note number and octave to a MIDI note (key 0, octave 0 = A3 = 57)
+    static int calculateMidiNote(int noteNumber, int octave);
 
 private:
+    // Open and start a stream for the given configuration, returns false on failure
+    bool openStream(const AudioConfig& config);
+
+    // Stop and close the current stream, if any
+    void closeStream();
+
     // PortAudio callback function (called repeatedly to fill audio buffer)
     static int audioCallback(const void *inputBuffer, 
                            void *outputBuffer,
@@ -55,11 +86,17 @@ private:
                            PaStreamCallbackFlags statusFlags,
                            void *userData);
 
-    std::mutex mutex;         // Mutex to protect access to parameters
+    // Stamp an event with the engine frame for "now" and queue it for the audio thread
+    void post(SynthEvent event);
+
+    // Hold back a note the queue had no room for, to be retried by flushPendingNotes()
+    void holdNote(const SynthEvent& event);
+
     PaStream* stream;          // PortAudio stream handle
-    TripleOscillator oscillator; // Synth engine: 3 oscillators + envelope
-    SynthParams* params;       // Pointer to user-defined parameters (UI-controlled)
-    LowPassFilter filter;      // Low-pass filter
+    SynthEngine engine;        // DSP core, owned by the audio thread once the stream runs
+    AudioConfig config;        // Current stream configuration
+    uint64_t lastEventFrame;   // Frame stamp of the last posted event
+    std::deque<SynthEvent> pendingNotes;  // Notes waiting for room in the event queue
 
 };
 
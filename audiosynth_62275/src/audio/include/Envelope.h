@@ -2,31 +2,73 @@
 #ifndef ENVELOPE_H
 #define ENVELOPE_H
 
-#include <mutex>
+#include "SynthConstants.h"
 
-// Simple envelope generator with attack and release stages
+// ADSR envelope generator with linear or exponential segments
+// Every segment is the recursion level = level * coef + base, so a block is one
+// multiply-add per sample; coef and base are set up only when the stage changes
+// Not thread-safe: owned and driven by the audio thread only (see SynthEngine)
 class Envelope {
 public:
-    Envelope() = default;
+    // Segment shape
+    enum class Curve {
+        Linear,       // Constant rate: a stage time is a full-scale (0 to 1) move
+        Exponential   // RC-style curves: fast start, slow approach, like an analog envelope
+    };
+
+    Envelope();
     // Set attack time in seconds
     void setAttack(float a);
+    // Set decay time in seconds
+    void setDecay(float d);
+    // Set sustain level (0 to 1)
+    void setSustain(float s);
     // Set release time in seconds
     void setRelease(float r);
-    // Start a new note
+    // Set the segment shape
+    void setCurve(Curve c);
+    // Start a new note (the attack starts from the current level)
     void noteOn();
     // Release the current note
     void noteOff();
     // Process the envelope and return current amplitude
     float process();
+    // Fill gains with the next count envelope values
+    void processBlock(float* gains, int count);
     // Set the sample rate for timing calculations
     void setSampleRate(float sr);
+    // Current amplitude, without advancing the envelope
+    float getLevel() const;
+    // True while the gate is on or the release has not reached zero
+    bool isActive() const;
 private:
-    std::mutex mutex;  // Mutex to protect access to parameters
+    enum class Stage { Idle, Attack, Decay, Sustain, Release };
+
+    // Recompute every segment's coefficients when a time, the sustain level, the curve or the sample rate changes
+    void updateCoefficients();
+    // Switch stage and load its coefficients
+    void enterStage(Stage s);
+    // Move on once the current segment has reached its end level
+    void finishStage();
+
     float attack = 0.01f;      // Attack time in seconds
+    float decay = 0.1f;        // Decay time in seconds
+    float sustain = 1.0f;      // Sustain level
     float release = 0.1f;      // Release time in seconds
+    Curve curve = Curve::Linear;
     float envelope = 0.0f;     // Current envelope value
-    bool gate = false;         // Note on/off state
-    float sampleRate = 44100.0f; // Sample rate for timing
+    Stage stage = Stage::Idle;
+    float sampleRate = static_cast<float>(SynthConstants::DEFAULT_SAMPLE_RATE); // Sample rate for timing
+
+    // Per-stage factors and linear steps (index = Stage), computed by updateCoefficients()
+    float coefs[5] = { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+    float steps[5] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+    // Current segment: level = level * coef + base until it reaches target
+    float coef = 1.0f;
+    float base = 0.0f;
+    float target = 0.0f;
+    bool rising = false;       // Direction of the current segment
 };
 
-#endif // ENVELOPE_H 
\ No newline at end of file
+#endif // ENVELOPE_H
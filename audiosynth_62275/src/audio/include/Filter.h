@@ -1,14 +1,18 @@
 #ifndef LOWPASS_FILTER_H
 #define LOWPASS_FILTER_H
 
-#include <mutex>
+#include <cstdint>
 
 // Simple Biquad Low-pass filter implementation
+// Not thread-safe: owned and driven by the audio thread only (see SynthEngine)
 class LowPassFilter {
 public:
     // Constructor initializing sample rate and default parameters
     LowPassFilter(float sampleRate);
 
+    // Set the sample rate (in Hz) and recalculate coefficients
+    void setSampleRate(float newSampleRate);
+
     // Set a new cutoff frequency (in Hz)
     void setCutoff(float newCutoff);
 
@@ -25,16 +29,41 @@ public:
     // Process a single input sample and return the filtered output
     float process(float input);
 
+    // Filter a buffer in place, same result as process() on each sample
+    void processBlock(float* samples, int count);
+
+    // True once the history has decayed below audibility (about -140 dB),
+    // so silent input would only give silent output
+    bool isSettled() const;
+
+    // Stand-in for process() over 'frames' samples of silence once settled:
+    // clears the history and keeps the LFO phase moving, leaving the coefficients
+    // to be worked out when processing resumes
+    void skipSilence(int frames);
+
 private:
     // Recalculate filter coefficients based on cutoff and resonance
     void updateCoefficients();
+
+    // Recalculate the coefficients, at the current LFO phase if they are stale
+    void refreshCoefficients();
     
-    // Update LFO phase and apply modulation to cutoff frequency
-    void updateLFO();
+    // True while the LFO modulates the cutoff
+    bool lfoActive() const;
+
+    // Control-rate LFO update: move the LFO one interval ahead and start a linear
+    // coefficient ramp from the last target to the coefficients there
+    void controlTick();
+
+    // Apply modulation at the current LFO phase without advancing it
+    void applyLFO();
     
     // Update cutoff frequency with current LFO modulation
     void updateCutoffWithLFO();
 
+    // Recompute the LFO phase increment from its frequency and the sample rate
+    void updateLFOStep();
+
     // Filter parameters
     float sampleRate;  // Sampling rate (Hz)
     float cutoff;      // Cutoff frequency (Hz)
@@ -43,18 +72,23 @@ private:
     // LFO parameters for automatic cutoff variation
     float lfoFrequency;    // LFO frequency in Hz
     float lfoAmount;       // LFO amount (0.0 to 1.0)
-    float lfoPhase;        // Current LFO phase (0.0 to 2π)
+    uint32_t lfoPhase;     // Current LFO phase, 2^32 = one cycle (wraps for free)
+    uint32_t lfoStep;      // LFO phase increment per sample, same scale
     float baseCutoff;      // Base cutoff frequency (without LFO modulation)
 
-    // Filter coefficients
+    // Filter coefficients (with the LFO on: the target at the end of the current ramp)
     float a0, a1, a2, b1, b2;
 
     // Filter state (history of inputs and outputs)
     float x1, x2;  // Previous inputs
     float y1, y2;  // Previous outputs
 
-    // Mutex for thread-safe operations
-    std::mutex mutex;
+    // Coefficient ramp while the LFO runs: the coefficients k samples into the interval
+    // are rampStart + rampStep * k, so any position can be reached without stepping
+    float rampStart[5];
+    float rampStep[5];
+    int controlPosition;   // Samples into the current interval (CONTROL_INTERVAL = tick due)
+    bool coefficientsStale; // skipSilence() moved the LFO phase past the coefficients
 };
 
 #endif // LOWPASS_FILTER_H
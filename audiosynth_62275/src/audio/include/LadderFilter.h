@@ -0,0 +1,176 @@
+#ifndef LADDER_FILTER_H
+#define LADDER_FILTER_H
+
+#include <cstdint>
+#include "OscillatorKernels.h"
+#include "SynthConstants.h"
+
+// Ladder kernels: one oversampled run of a bank of 4-pole ladders, scalar reference
+// plus SIMD versions where every lane is one filter instance (SSE2: 4, AVX2: 8)
+namespace LadderKernels {
+
+    constexpr int LANES = 8;              // Filter instances in a bank
+    constexpr int LANE_GROUP = 4;         // Lanes are processed in groups of this many (one SSE2 register)
+    constexpr int MAX_OVERSAMPLING = 4;
+
+    // Filter state, structure of arrays: element [l] of each row belongs to instance l
+    struct State {
+        alignas(32) float stage[4][LANES];  // One-pole integrator states
+        alignas(32) float previous[LANES];  // Last input sample, for the upsampling interpolation
+    };
+
+    // Per-sample values shared by every lane, worked out in scalar code by LadderFilter
+    // so each kernel runs the same float operations
+    // The ladder output for input x is G^4 x + sigma, where sigma is the state's share:
+    // G^3 (1 - G) s0 + G^2 (1 - G) s1 + G (1 - G) s2 + (1 - G) s3. Solving the feedback
+    // loop x = in - feedback * output then gives x = (in - feedback * sigma) * solve
+    struct Coefficients {
+        float g;          // One-pole gain G = g / (1 + g), g = tan(pi * cutoff / oversampled rate)
+        float oneMinusG;  // Also the weight of s3 in sigma
+        float weights[3]; // Weights of s0, s1 and s2 in sigma
+        float solve;      // 1 / (1 + feedback * G^4)
+    };
+
+    // Settings fixed for a whole run
+    struct Settings {
+        float feedback;    // 0 to 4; 4 is the edge of self-oscillation
+        float drive;       // Input gain into the saturation
+        int oversampling;  // Steps per sample: 1, 2 or 4
+    };
+
+    // Filter 'count' frames of interleaved lanes in place (frames[i * LANES + l] is sample i
+    // of instance l), for the first 'lanes' instances; lanes is a multiple of LANE_GROUP.
+    // Each step solves the linear feedback loop for the ladder input, saturates it with a
+    // rational tanh, then runs the four one-pole stages from there.
+    // Input is upsampled by linear interpolation and output decimated by averaging.
+    // All kernels do the same float operations per lane, in the same order, so their
+    // output is bit-identical (the kernel sources are built without FMA contraction)
+    using Kernel = void (*)(State& state, const Coefficients* coefficients, const Settings& settings,
+                            float* frames, int count, int lanes);
+
+    void processScalar(State& state, const Coefficients* coefficients, const Settings& settings,
+                       float* frames, int count, int lanes);
+#ifdef AUDIOSYNTH_X86_KERNELS
+    void processSSE2(State& state, const Coefficients* coefficients, const Settings& settings,
+                     float* frames, int count, int lanes);
+    void processAVX2(State& state, const Coefficients* coefficients, const Settings& settings,
+                     float* frames, int count, int lanes);
+#endif
+
+    // Kernel for an instruction set (must not be wider than OscillatorKernels::detectIsa());
+    // AVX2 and wider get the AVX2 kernel: 8 lanes per register, a last group of 4 with SSE2
+    Kernel kernel(OscillatorKernels::Isa isa);
+
+    // Interpolation position of each oversampled step, indexed [oversampling / 2][step]
+    constexpr float STEP_POSITIONS[3][MAX_OVERSAMPLING] = {
+        { 1.0f, 0.0f, 0.0f, 0.0f },
+        { 0.5f, 1.0f, 0.0f, 0.0f },
+        { 0.25f, 0.5f, 0.75f, 1.0f },
+    };
+
+    // tanh(x) as x (27 + x^2) / (27 + 9 x^2), which reaches exactly 1 at x = 3, clamped there
+    // static: each kernel source gets its own copy built for its instruction set
+    static inline float saturate(float x) {
+        float x2 = x * x;
+        float y = (x * (27.0f + x2)) / (27.0f + 9.0f * x2);
+        return y < -1.0f ? -1.0f : (y > 1.0f ? 1.0f : y);
+    }
+
+} // namespace LadderKernels
+
+// 4-pole (24 dB/oct) transistor-ladder low-pass with input drive, run oversampled
+// around its saturation. A bank of up to LANES independent instances sharing one set
+// of parameters: their state is laid out so one SIMD register steps 4 or 8 of them,
+// so a stereo pair, a voice pool or a unison stack costs little more than one filter
+// Not thread-safe: owned and driven by the audio thread only (see SynthEngine)
+class LadderFilter {
+public:
+    static constexpr int LANES = LadderKernels::LANES;
+
+    // Constructor initializing sample rate and default parameters
+    explicit LadderFilter(float sampleRate);
+
+    // Set the sample rate (in Hz) and recalculate coefficients
+    void setSampleRate(float newSampleRate);
+
+    // Set a new cutoff frequency (in Hz)
+    void setCutoff(float newCutoff);
+
+    // Set a new resonance (0.0 to 0.99; self-oscillation starts near 1.0)
+    void setResonance(float newResonance);
+
+    // Set the input gain into the saturation (1.0 = unity, higher is dirtier)
+    void setDrive(float newDrive);
+
+    // Set the oversampling factor: 1, 2 or 4 (other values round down to one of these)
+    void setOversampling(int factor);
+
+    // Set LFO parameters for automatic cutoff variation (same range as LowPassFilter)
+    void setAutoVariationFrequency(float frequency);
+    void setAutoVariationAmount(float amount);
+
+    // Reset every instance
+    void reset();
+
+    // Filter 'lanes' channel buffers in place, instance l on channels[l]
+    // Instances past 'lanes' in the same group of LANE_GROUP are fed silence
+    void processBlock(float* const* channels, int lanes, int count);
+
+    // Copy the state of one instance to another (keeps an unused instance in step)
+    void copyLane(int from, int to);
+
+    // True once every instance has decayed below audibility (about -140 dB),
+    // so silent input would only give silent output
+    bool isSettled() const;
+
+    // Stand-in for processBlock() over 'frames' samples of silence once settled:
+    // clears the state and keeps the LFO phase moving
+    void skipSilence(int frames);
+
+private:
+    // Recalculate the one-pole gain for the current cutoff
+    void updateCoefficients();
+
+    // True while the LFO modulates the cutoff
+    bool lfoActive() const;
+
+    // Control-rate LFO update: move the LFO one interval ahead and start a linear
+    // ramp of the one-pole gain towards its value there
+    void controlTick();
+
+    // Recompute the LFO phase increment from its frequency and the sample rate
+    void updateLFOStep();
+
+    // One-pole gain G for a cutoff at the oversampled rate
+    float stageGain(float frequency) const;
+
+    // Filter parameters
+    float sampleRate;      // Sampling rate (Hz)
+    float cutoff;          // Cutoff frequency (Hz)
+    float resonance;       // Resonance amount (0 to 0.99)
+    float drive;           // Input gain into the saturation
+    int oversampling;      // Steps per sample: 1, 2 or 4
+
+    // LFO parameters for automatic cutoff variation
+    float lfoFrequency;    // LFO frequency in Hz
+    float lfoAmount;       // LFO amount (0.0 to 1.0)
+    uint32_t lfoPhase;     // Current LFO phase, 2^32 = one cycle (wraps for free)
+    uint32_t lfoStep;      // LFO phase increment per sample, same scale
+
+    // One-pole gain (with the LFO on: the target at the end of the current ramp)
+    float gain;
+
+    // Gain ramp while the LFO runs: k samples into the interval it is rampStart + rampStep * k
+    float rampStart;
+    float rampStep;
+    int controlPosition;   // Samples into the current interval (CONTROL_INTERVAL = tick due)
+
+    LadderKernels::Kernel kernel;   // Widest kernel this CPU supports
+    LadderKernels::State state;
+
+    // Interleaved scratch frames and their coefficients, one sub-block at a time
+    alignas(32) float frames[SynthConstants::RENDER_BLOCK_SIZE * LANES];
+    LadderKernels::Coefficients coefficients[SynthConstants::RENDER_BLOCK_SIZE];
+};
+
+#endif // LADDER_FILTER_H
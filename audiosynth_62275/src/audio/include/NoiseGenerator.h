@@ -0,0 +1,52 @@
+// NoiseGenerator.h
+// Per-instance white, pink and brown noise, generated in blocks
+
+
+#ifndef AUDIOSYNTH_NOISEGENERATOR_H
+#define AUDIOSYNTH_NOISEGENERATOR_H
+
+#include <cstdint>
+
+// Noise source owned by one oscillator: no global state, so engines and voices
+// never interfere and the same seed always gives the same samples.
+// White noise comes from LANES interleaved xorshift32 streams stepped together,
+// a loop of shifts and xors that the compiler turns into SIMD integer code.
+// Pink and brown noise filter that white noise with cheap recursive filters.
+// Not thread-safe: owned and driven by the audio thread only (see SynthEngine)
+class NoiseGenerator {
+public:
+    // Spectral colour of the output
+    enum class Color {
+        White,  // Flat spectrum
+        Pink,   // -3 dB per octave (Paul Kellet's economy filter)
+        Brown   // -6 dB per octave (leaky integrator)
+    };
+
+    // Constructor: seeded with SynthConstants::DEFAULT_NOISE_SEED
+    NoiseGenerator();
+
+    // Restart every stream from a seed (same seed = same noise)
+    void setSeed(uint32_t seed);
+
+    // Render 'count' samples of the given colour: white peaks at +-amplitude,
+    // pink and brown are scaled to the same RMS level. Output does not depend on how a run of samples is split into calls
+    void process(Color color, float amplitude, float* out, int count);
+
+private:
+    static constexpr int LANES = 8;
+
+    // Advance every stream once and write LANES white samples in -1 to 1
+    void nextWhite(float* out);
+
+    // Fill 'out' with white noise, continuing the interleaved sequence
+    void white(float* out, int count);
+
+    alignas(32) uint32_t state[LANES];  // xorshift32 state per stream (never 0)
+    alignas(32) float pending[LANES];   // Samples generated but not yet handed out
+    int pendingIndex;                   // Next unread entry of pending (LANES = empty)
+
+    float pink[3];   // Pink filter poles
+    float brown;     // Brown integrator state
+};
+
+#endif // AUDIOSYNTH_NOISEGENERATOR_H
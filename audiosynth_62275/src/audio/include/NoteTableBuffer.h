@@ -0,0 +1,34 @@
+#ifndef AUDIOSYNTH_NOTETABLEBUFFER_H
+#define AUDIOSYNTH_NOTETABLEBUFFER_H
+
+#include <atomic>
+#include <cstdint>
+#include "Tuning.h"
+
+// NoteTableBuffer: wait-free triple buffer carrying note tables (the frequency of
+// every MIDI note) from a single writer (GUI thread) to a single reader (audio thread),
+// the same handover as SynthParamsBuffer. A table is too large for an event, and unlike
+// parameters it rarely changes, so the reader only takes a table when a new one is there.
+class NoteTableBuffer {
+public:
+    // Constructor: nothing published yet
+    NoteTableBuffer();
+
+    // Writer side: publish the note table of a tuning
+    void publish(const Tuning& tuning);
+
+    // Reader side: the table published since the last call, or null if there is none
+    // The table stays valid until the next call to take()
+    const Tuning::NoteTable* take();
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;  // Slot index bits of 'shared'
+    static constexpr uint8_t FRESH_BIT = 0x4;   // Set when 'shared' holds an unread table
+
+    Tuning::NoteTable slots[3];        // Back (writer), shared and front (reader) slots
+    std::atomic<uint8_t> shared;       // Index of the shared slot plus FRESH_BIT
+    uint8_t writeIndex;                // Slot owned by the writer
+    uint8_t readIndex;                 // Slot owned by the reader
+};
+
+#endif // AUDIOSYNTH_NOTETABLEBUFFER_H
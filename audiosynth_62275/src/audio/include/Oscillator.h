@@ -6,17 +6,25 @@
 #define SIMPLE_SYNTH_OSCILLATOR_H
 
 #include <cmath>
-#include <mutex>
+#include <cstdint>
 #include "SynthConstants.h"
+#include "OscillatorKernels.h"
+#include "NoiseGenerator.h"
 
 // Oscillator class that generates different waveforms
+// Not thread-safe: owned and driven by the audio thread only (see SynthEngine)
 class Oscillator {
 public:
     // Available waveform types
+    // Triangle, Saw, Square and Pulse are read from band-limited wavetables (see Wavetable)
     enum class Waveform {
         Triangle,    // Triangle wave
         Noise,       // Noise wave
-        Saw          // Sawtooth wave
+        Saw,         // Sawtooth wave
+        Square,      // Square wave (50% duty cycle)
+        Pulse,       // Pulse wave (25% duty cycle)
+        PinkNoise,   // Pink noise (-3 dB per octave)
+        BrownNoise   // Brown noise (-6 dB per octave)
     };
 
     // Constructor initializes oscillator parameters
@@ -24,6 +32,10 @@ public:
 
     // Set the oscillator frequency in Hz
     void setFrequency(double freq);
+
+    // Set the pitch as a phase increment per sample (2^32 = one cycle), as read from
+    // the voice pool's per-note table: no division or pow on note-on
+    void setPhaseIncrement(double increment);
     
     // Set the waveform type
     void setWaveform(Waveform wf);
@@ -35,27 +47,67 @@ public:
     // Set frequency offset in semitones
     void setFrequencyOffset(float offset);
 
-    // Process a buffer of samples
-    void processBuffer(float* buffer, int bufferSize);
+    // Set the sample rate used to compute the phase step
+    void setSampleRate(double sr);
+
+    // Seed this oscillator's own noise generator (same seed = same noise)
+    void setSeed(uint32_t seed);
+
+    // Unison: stack 1 to MAX_UNISON copies of the waveform, detuned evenly over
+    // 'detune' cents in total and panned over 'spread' (0 = centre, 1 = full width).
+    // Noise waveforms ignore it
+    void setUnison(int count);
+    void setUnisonDetune(float cents);
+    void setUnisonSpread(float spread);
+
+    // True when the stereo processBuffer gives different left and right channels
+    bool isStereo() const;
+
+    // Process a buffer of samples with the SIMD kernel picked for this CPU
+    // phaseModulation, if not null, holds one phase offset per sample (2^32 = one cycle)
+    // added to the read position: phase modulation by another oscillator (noise ignores it)
+    void processBuffer(float* buffer, int bufferSize, const uint32_t* phaseModulation = nullptr);
+    // Same, with the unison stack panned across left and right
+    void processBuffer(float* left, float* right, int bufferSize, const uint32_t* phaseModulation = nullptr);
 
-    // Phase control methods
+    // Phase control methods (radians, 0.0 to 2π)
     double getPhase() const;
     void setPhase(double newPhase);
 
 private:
-    // Generate a single sample based on current waveform
-    float generateSample();
-
-    // Update phase step based on current frequency
+    // Update phase step based on the current pitch
     void updatePhaseStep();
 
-    mutable std::mutex mutex;       // Mutex to protect access to parameters
-    double frequency;        // Base frequency in Hz
-    double phase;           // Current phase (0.0 to 2π)
-    double phaseStep;       // Phase increment per sample
+    // Recompute the pitch ratio of each unison copy (offset and detune)
+    void updateStepRatios();
+
+    // Recompute the per-copy gains of the unison stack
+    void updateUnisonGains();
+
+    // Render a buffer of noise; false for table waveforms
+    bool processNoise(float* buffer, int bufferSize);
+
+    // Pick the wavetable level for the current waveform and pitch
+    void selectTable();
+
+    double phaseIncrement;   // Base pitch as a phase increment per sample, 2^32 = one cycle
+    uint32_t phases[SynthConstants::MAX_UNISON];  // Phase of each unison copy, 2^32 = one cycle (wraps for free)
+    uint32_t steps[SynthConstants::MAX_UNISON];   // Phase increment per sample of each copy, same scale
+    double stepRatios[SynthConstants::MAX_UNISON]; // Pitch of each copy relative to phaseIncrement
+    float gainsLeft[SynthConstants::MAX_UNISON];  // Per-copy gains (amplitude, stack size and pan)
+    float gainsRight[SynthConstants::MAX_UNISON];
+    float gainsCentre[SynthConstants::MAX_UNISON];
+    int unisonCount;        // Number of stacked copies (1 = plain oscillator)
+    float unisonDetune;     // Total detune across the stack in cents
+    float unisonSpread;     // Stereo width of the stack, 0 to 1
     Waveform waveform;      // Current waveform type
     bool isEnabled;         // Oscillator enabled state
     float frequencyOffset;  // Frequency offset in semitones
+    double sampleRate;      // Sample rate in Hz
+    NoiseGenerator noise;   // Per-instance noise source for the noise waveforms
+    const float* table;     // Current mip-map level of the waveform's wavetable
+    OscillatorKernels::TableKernel tableKernel;  // Widest kernels this CPU supports
+    OscillatorKernels::UnisonKernel unisonKernel;
 };
 
 #endif //SIMPLE_SYNTH_OSCILLATOR_H 
\ No newline at end of file
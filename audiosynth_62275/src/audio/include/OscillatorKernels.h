@@ -0,0 +1,123 @@
+// OscillatorKernels.h
+// Block kernels for wavetable oscillators: scalar reference plus SIMD versions
+// (SSE2, AVX2, AVX-512 on x86-64), the best one picked at runtime
+
+
+#ifndef AUDIOSYNTH_OSCILLATORKERNELS_H
+#define AUDIOSYNTH_OSCILLATORKERNELS_H
+
+#include <cstdint>
+#include "Wavetable.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define AUDIOSYNTH_X86_KERNELS 1
+#endif
+
+namespace OscillatorKernels {
+
+    // Instruction sets with a kernel, in increasing order of width
+    enum class Isa {
+        Scalar,
+        SSE2,    // 4 samples per instruction
+        AVX2,    // 8 samples per instruction
+        AVX512   // 16 samples per instruction
+    };
+
+    // Render 'count' samples of a wavetable (see Wavetable::select) scaled by amplitude.
+    // phase and step are 32-bit accumulators (2^32 = one cycle): wraparound is free,
+    // the top TABLE_BITS are the table index and the rest the interpolation fraction.
+    // modulation, if not null, holds one phase offset per sample (same scale) added to
+    // the read position only: phase modulation that leaves the accumulator untouched.
+    // Returns the phase after the block.
+    // Phase math is exact integer math, and every kernel then computes the same float
+    // operations, so all of them produce bit-identical output however a run is split
+    // into blocks (the kernel sources are built without FMA contraction)
+    using TableKernel = uint32_t (*)(const float* table, uint32_t phase, uint32_t step, const uint32_t* modulation,
+                                     float amplitude, float* out, int count);
+
+    uint32_t renderTableScalar(const float* table, uint32_t phase, uint32_t step, const uint32_t* modulation,
+                               float amplitude, float* out, int count);
+#ifdef AUDIOSYNTH_X86_KERNELS
+    uint32_t renderTableSSE2(const float* table, uint32_t phase, uint32_t step, const uint32_t* modulation,
+                             float amplitude, float* out, int count);
+    uint32_t renderTableAVX2(const float* table, uint32_t phase, uint32_t step, const uint32_t* modulation,
+                             float amplitude, float* out, int count);
+    uint32_t renderTableAVX512(const float* table, uint32_t phase, uint32_t step, const uint32_t* modulation,
+                               float amplitude, float* out, int count);
+#endif
+
+    // Render a unison stack: 'voices' copies of one table, each with its own phase and step,
+    // summed with per-voice gains into outLeft and (if not null) outRight.
+    // modulation (if not null) is added to every copy's read position, as for TableKernel.
+    // Lanes run along time; every stacked voice is added into the same registers,
+    // so a stack costs one pass over the block. Advances phases[] by 'count' samples.
+    // Voices are accumulated in index order in every kernel, so output is bit-identical too
+    using UnisonKernel = void (*)(const float* table, uint32_t* phases, const uint32_t* steps, const uint32_t* modulation,
+                                  const float* gainsLeft, const float* gainsRight, int voices,
+                                  float* outLeft, float* outRight, int count);
+
+    void renderUnisonScalar(const float* table, uint32_t* phases, const uint32_t* steps, const uint32_t* modulation,
+                            const float* gainsLeft, const float* gainsRight, int voices,
+                            float* outLeft, float* outRight, int count);
+#ifdef AUDIOSYNTH_X86_KERNELS
+    void renderUnisonSSE2(const float* table, uint32_t* phases, const uint32_t* steps, const uint32_t* modulation,
+                          const float* gainsLeft, const float* gainsRight, int voices,
+                          float* outLeft, float* outRight, int count);
+    void renderUnisonAVX2(const float* table, uint32_t* phases, const uint32_t* steps, const uint32_t* modulation,
+                          const float* gainsLeft, const float* gainsRight, int voices,
+                          float* outLeft, float* outRight, int count);
+    void renderUnisonAVX512(const float* table, uint32_t* phases, const uint32_t* steps, const uint32_t* modulation,
+                            const float* gainsLeft, const float* gainsRight, int voices,
+                            float* outLeft, float* outRight, int count);
+#endif
+
+    // Widest instruction set this CPU and OS support (detected once)
+    Isa detectIsa();
+    const char* isaName(Isa isa);
+
+    // Kernels for an instruction set (must not be wider than detectIsa())
+    TableKernel tableKernel(Isa isa);
+    UnisonKernel unisonKernel(Isa isa);
+
+    // Bits below the table index, and the scale that turns them into a 0 to 1 fraction
+    constexpr int FRAC_BITS = 32 - Wavetable::TABLE_BITS;
+    constexpr uint32_t FRAC_MASK = (1u << FRAC_BITS) - 1u;
+    constexpr float FRAC_SCALE = 1.0f / static_cast<float>(1u << FRAC_BITS);
+
+    // One sample at a phase, shared by the scalar kernel and the SIMD tails.
+    // static: each kernel source gets its own copy built for its instruction set
+    static inline float tableSample(const float* table, uint32_t phase, float amplitude) {
+        uint32_t index = phase >> FRAC_BITS;
+        float frac = static_cast<float>(static_cast<int32_t>(phase & FRAC_MASK)) * FRAC_SCALE;
+        // index + 1 reads the guard sample stored after TABLE_SIZE
+        return (table[index] + frac * (table[index + 1] - table[index])) * amplitude;
+    }
+
+    // Samples [start, count) of a unison stack, one at a time: the scalar kernel and the SIMD tails
+    static inline void unisonTail(const float* table, const uint32_t* phases, const uint32_t* steps, const uint32_t* modulation,
+                                  const float* gainsLeft, const float* gainsRight, int voices,
+                                  float* outLeft, float* outRight, int start, int count) {
+        for (int i = start; i < count; i++) {
+            uint32_t offset = modulation ? modulation[i] : 0u;
+            float left = 0.0f;
+            float right = 0.0f;
+            for (int v = 0; v < voices; v++) {
+                float sample = tableSample(table, phases[v] + steps[v] * static_cast<uint32_t>(i) + offset, 1.0f);
+                left = left + sample * gainsLeft[v];
+                right = right + sample * gainsRight[v];
+            }
+            outLeft[i] = left;
+            if (outRight) outRight[i] = right;
+        }
+    }
+
+    // Advance every phase of a unison stack by 'count' samples
+    static inline void unisonAdvance(uint32_t* phases, const uint32_t* steps, int voices, int count) {
+        for (int v = 0; v < voices; v++) {
+            phases[v] += steps[v] * static_cast<uint32_t>(count);
+        }
+    }
+
+} // namespace OscillatorKernels
+
+#endif // AUDIOSYNTH_OSCILLATORKERNELS_H
@@ -0,0 +1,32 @@
+#ifndef AUDIOSYNTH_PATCH_H
+#define AUDIOSYNTH_PATCH_H
+
+#include <cstdint>
+#include <string>
+#include "SynthParams.h"
+#include "SynthConstants.h"
+#include "Tuning.h"
+
+class SynthEngine;
+class SynthParamsBuffer;
+
+// Patch: a complete synth setup (parameters plus oscillator settings)
+// Loaded from a text file of "key = value" lines, where keys are the
+// SynthParams field names (attack, filter_cutoff, osc2_waveform, ...) or
+// sample_rate or seed; '#' starts a comment
+// 'scale' and 'keyboard_mapping' name Scala .scl / .kbm files, relative to the patch
+struct Patch {
+    SynthParams params;                                         // Parameters and oscillator settings
+    double sampleRate { SynthConstants::DEFAULT_SAMPLE_RATE };  // Rate the patch is rendered at
+    uint32_t seed { SynthConstants::DEFAULT_NOISE_SEED };       // Noise seed, for reproducible renders
+    Tuning tuning;                                              // Note tuning, equal temperament by default
+
+    // Load a patch file; returns false and describes the problem in error
+    bool load(const std::string& path, std::string& error);
+
+    // Publish the parameters and queue the oscillator settings on an engine
+    // Also sets the engine's tuning, so call it before the engine renders
+    void apply(SynthEngine& engine, SynthParamsBuffer& buffer) const;
+};
+
+#endif // AUDIOSYNTH_PATCH_H
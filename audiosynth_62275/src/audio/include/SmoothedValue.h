@@ -0,0 +1,69 @@
+#ifndef SMOOTHED_VALUE_H
+#define SMOOTHED_VALUE_H
+
+// Parameter that glides to a new value instead of jumping to it, so UI moves and
+// automation do not step audibly (zipper noise)
+// A ramp lasts the smoothing time whatever the size of the change and ends exactly on
+// the target; isSmoothing() is the dirty flag, so whatever is derived from the value
+// (filter coefficients, ...) only needs recomputing while it is true
+// Not thread-safe: owned and driven by the audio thread only (see SynthEngine)
+class SmoothedValue {
+public:
+    // Ramp shape
+    enum class Curve {
+        Linear,   // Constant rate of change: even steps, for gains and amounts
+        OnePole   // Exponential approach: fast start, gentle landing, for frequencies
+    };
+
+    // Constructor: settled on 'initial'
+    explicit SmoothedValue(float initial = 0.0f, Curve curve = Curve::Linear);
+
+    // Set the sample rate (in Hz) and the smoothing time (in seconds)
+    // Both apply from the next ramp on: a running ramp keeps its length
+    void setSampleRate(float sr);
+    void setSmoothingTime(float seconds);
+
+    // Glide from the current value to a new target over the smoothing time
+    // Parameters are re-applied every block, so an unchanged target returns early
+    void setTarget(float newTarget);
+
+    // Jump to a value at once, ending any ramp
+    void setImmediate(float value);
+
+    // Current value, without advancing
+    float getCurrent() const;
+
+    // Value the ramp ends on
+    float getTarget() const;
+
+    // True while the value is still moving towards the target
+    bool isSmoothing() const;
+
+    // Advance 'frames' samples and return the value reached
+    float advance(int frames);
+
+    // Write the value of each of the next 'count' samples and advance past them
+    void fill(float* values, int count);
+
+private:
+    // Value 'steps' samples further along the current ramp (steps <= remaining)
+    float step(int steps);
+
+    Curve curve;
+    float sampleRate;      // Sampling rate (Hz)
+    float smoothingTime;   // Ramp length in seconds
+    float current;         // Value reached so far
+    float target;          // Value the ramp ends on
+
+    // Linear: at position k into the ramp the value is rampStart + rampStep * k,
+    // worked out from the start so any split of the ramp lands on the same values
+    float rampStart;
+    float rampStep;
+    // One-pole: distance to the target is multiplied by this every sample
+    float decay;
+
+    int rampLength;        // Samples in the current ramp
+    int position;          // Samples into the current ramp
+};
+
+#endif // SMOOTHED_VALUE_H
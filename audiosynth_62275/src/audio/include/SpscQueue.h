@@ -0,0 +1,62 @@
+#ifndef AUDIOSYNTH_SPSCQUEUE_H
+#define AUDIOSYNTH_SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+// SpscQueue: bounded lock-free single-producer / single-consumer ring buffer
+// One thread may push, one other thread may pop; neither ever blocks.
+// Capacity must be a power of two; one slot is never used to tell full from empty.
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue capacity must be a power of two");
+
+public:
+    // Producer side: append an item, returns false if the queue is full
+    bool push(const T& item) {
+        std::size_t tail = writeIndex.load(std::memory_order_relaxed);
+        std::size_t next = (tail + 1) & MASK;
+        if (next == readIndex.load(std::memory_order_acquire)) {
+            return false;
+        }
+        items[tail] = item;
+        writeIndex.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: remove the oldest item, returns false if the queue is empty
+    bool pop(T& item) {
+        std::size_t head = readIndex.load(std::memory_order_relaxed);
+        if (head == writeIndex.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = items[head];
+        readIndex.store((head + 1) & MASK, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: peek at the oldest item without removing it, nullptr if empty
+    const T* front() const {
+        std::size_t head = readIndex.load(std::memory_order_relaxed);
+        if (head == writeIndex.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &items[head];
+    }
+
+    // Consumer side: drop the item returned by front()
+    void popFront() {
+        std::size_t head = readIndex.load(std::memory_order_relaxed);
+        readIndex.store((head + 1) & MASK, std::memory_order_release);
+    }
+
+private:
+    static constexpr std::size_t MASK = Capacity - 1;
+
+    alignas(64) std::atomic<std::size_t> writeIndex { 0 }; // Next slot to fill (producer)
+    alignas(64) std::atomic<std::size_t> readIndex { 0 };  // Next slot to read (consumer)
+    T items[Capacity];
+};
+
+#endif // AUDIOSYNTH_SPSCQUEUE_H
@@ -0,0 +1,100 @@
+#ifndef STATE_VARIABLE_FILTER_H
+#define STATE_VARIABLE_FILTER_H
+
+#include <cstdint>
+
+// Zero-delay-feedback (TPT) state-variable filter
+// One topology-preserving update per sample gives the low-pass, band-pass and high-pass
+// signals at once; each mode is a fixed mix of them, so switching modes costs nothing.
+// Stays stable under any cutoff movement, and the coefficients are a rational tan
+// approximation and one division, cheap enough to recompute every sample
+// Not thread-safe: owned and driven by the audio thread only (see SynthEngine)
+class StateVariableFilter {
+public:
+    // Output taken from the filter
+    enum class Mode {
+        LowPass,
+        HighPass,
+        BandPass,   // Normalized: unity gain at the cutoff whatever the resonance
+        Notch,
+        Peak        // Low-pass minus high-pass: a resonant boost around the cutoff
+    };
+
+    // Constructor initializing sample rate and default parameters
+    explicit StateVariableFilter(float sampleRate);
+
+    // Set the sample rate (in Hz) and recalculate coefficients
+    void setSampleRate(float newSampleRate);
+
+    // Set a new cutoff frequency (in Hz)
+    void setCutoff(float newCutoff);
+
+    // Set a new resonance (0.0 to 0.99, same Q mapping as LowPassFilter)
+    void setResonance(float newResonance);
+
+    // Select the output mode
+    void setMode(Mode newMode);
+
+    // Set LFO parameters for automatic cutoff variation (same range as LowPassFilter)
+    void setAutoVariationFrequency(float frequency);
+    void setAutoVariationAmount(float amount);
+
+    // Reset filter state
+    void reset();
+
+    // Process a single input sample and return the filtered output
+    float process(float input);
+
+    // Filter a buffer in place, same result as process() on each sample
+    // With the LFO on, the cutoff is modulated at audio rate
+    void processBlock(float* samples, int count);
+
+    // Filter a buffer in place with a cutoff in Hz per sample (audio-rate modulation);
+    // the set cutoff and the LFO are ignored
+    void processBlock(float* samples, const float* cutoffs, int count);
+
+    // True once the state has decayed below audibility (about -140 dB),
+    // so silent input would only give silent output
+    bool isSettled() const;
+
+    // Stand-in for process() over 'frames' samples of silence once settled:
+    // clears the state and keeps the LFO phase moving
+    void skipSilence(int frames);
+
+private:
+    // Recalculate the coefficients for the set cutoff
+    void updateCoefficients();
+
+    // Recalculate the damping and the output mix from resonance and mode
+    void updateMix();
+
+    // True while the LFO modulates the cutoff
+    bool lfoActive() const;
+
+    // Recompute the LFO phase increment from its frequency and the sample rate
+    void updateLFOStep();
+
+    // Filter parameters
+    float sampleRate;      // Sampling rate (Hz)
+    float cutoff;          // Cutoff frequency (Hz)
+    float resonance;       // Resonance amount (mapped to Q)
+    Mode mode;
+
+    // LFO parameters for automatic cutoff variation
+    float lfoFrequency;    // LFO frequency in Hz
+    float lfoAmount;       // LFO amount (0.0 to 1.0)
+    uint32_t lfoPhase;     // Current LFO phase, 2^32 = one cycle (wraps for free)
+    uint32_t lfoStep;      // LFO phase increment per sample, same scale
+
+    // Coefficients for the set cutoff: k = 1 / Q, a1..a3 from g = tan(pi * cutoff / sampleRate)
+    float k;
+    float a1, a2, a3;
+
+    // Output = mixInput * input + mixBand * band + mixLow * low
+    float mixInput, mixBand, mixLow;
+
+    // Integrator states
+    float ic1eq, ic2eq;
+};
+
+#endif // STATE_VARIABLE_FILTER_H
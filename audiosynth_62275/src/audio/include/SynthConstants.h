@@ -1,10 +1,25 @@
 #ifndef AUDIOSYNTH_SYNTHCONSTANTS_H
 #define AUDIOSYNTH_SYNTHCONSTANTS_H
 
+#include <cmath>
+
 namespace SynthConstants {
     constexpr double TWO_PI = 2.0 * M_PI;
-    constexpr int SAMPLE_RATE = 44100;
+    constexpr double PHASE_CYCLE = 4294967296.0;  // One cycle of a 32-bit phase accumulator (2^32)
+    constexpr double DEFAULT_SAMPLE_RATE = 44100.0;
+    constexpr double SUPPORTED_SAMPLE_RATES[] = { 44100.0, 48000.0, 96000.0, 192000.0 };
     constexpr float BASE_AMPLITUDE = 0.5f;
+    constexpr int FRAMES_PER_BUFFER = 256;   // Frames requested from the audio device per callback
+    constexpr int RENDER_BLOCK_SIZE = 64;    // Internal sub-block size, independent of the host buffer size
+    constexpr int CONTROL_INTERVAL = 32;     // Samples between control-rate updates (filter LFO)
+    constexpr int MAX_VOICES = 64;           // Size of the polyphonic voice pool
+    constexpr int MAX_UNISON = 16;           // Most stacked copies per oscillator (unison / supersaw)
+    constexpr float MAX_MODULATION_INDEX = 10.0f;  // Largest FM / PM index between oscillators (radians)
+    constexpr unsigned int DEFAULT_NOISE_SEED = 1;  // Default seed so renders are reproducible
+    constexpr int EVENT_QUEUE_SIZE = 1024;   // Capacity of the control -> audio thread event queue
+    constexpr float VOLUME_SMOOTHING_TIME = 0.02f;     // Seconds for a volume change to ramp in
+    constexpr float CUTOFF_SMOOTHING_TIME = 0.05f;     // Seconds for a filter cutoff change to settle
+    constexpr float RESONANCE_SMOOTHING_TIME = 0.05f;  // Seconds for a filter resonance change to settle
 
     
 } // namespace SynthConstants
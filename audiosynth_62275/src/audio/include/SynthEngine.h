@@ -0,0 +1,117 @@
+#ifndef AUDIOSYNTH_SYNTHENGINE_H
+#define AUDIOSYNTH_SYNTHENGINE_H
+
+#include <atomic>
+#include <cstdint>
+#include "VoicePool.h"
+#include "Filter.h"
+#include "StateVariableFilter.h"
+#include "LadderFilter.h"
+#include "SmoothedValue.h"
+#include "SynthParamsBuffer.h"
+#include "NoteTableBuffer.h"
+#include "Tuning.h"
+#include "SynthEvent.h"
+#include "SpscQueue.h"
+
+// Filter model run on the voice mix
+enum class FilterType {
+    Biquad,         // LowPassFilter: 12 dB/oct low-pass
+    StateVariable,  // StateVariableFilter: low-pass, high-pass, band-pass, notch or peak
+    Ladder          // LadderFilter: 24 dB/oct low-pass with drive, oversampled
+};
+
+// SynthEngine: single-owner DSP core
+// All DSP state (voices, oscillators, envelopes, filter) is touched by the audio thread only.
+// Other threads change it by posting SynthEvents or publishing SynthParams snapshots,
+// so the render path takes no locks.
+class SynthEngine {
+public:
+    // Constructor: reads parameter snapshots from the given buffer
+    explicit SynthEngine(SynthParamsBuffer* params,
+                         double sampleRate = SynthConstants::DEFAULT_SAMPLE_RATE);
+
+    // Change the sample rate of every DSP module
+    // Not an event: call only while no audio thread is rendering (stream stopped)
+    void setSampleRate(double sr);
+    double getSampleRate() const;
+
+    // Control thread: replace the note tuning (frequency of every MIDI note)
+    // Not an event: the table is too large for one, so it is handed over through a
+    // NoteTableBuffer and applied at the start of the next render(); notes already
+    // sounding keep their pitch
+    void setTuning(const Tuning& tuning);
+
+    // Control thread: queue an event for the audio thread
+    // Single producer only; returns false if the queue is full
+    bool postEvent(const SynthEvent& event);
+
+    // Any thread: engine frame at which an event posted now should take effect
+    // Extrapolated from the last rendered block plus one block of latency,
+    // so events keep their relative timing inside the next block
+    uint64_t frameTime() const;
+
+    // Audio thread: render interleaved stereo frames into out
+    // Any frame count is accepted: the block is rendered in sub-blocks of at most
+    // RENDER_BLOCK_SIZE frames on a fixed frame grid, split further at each event's exact frame
+    void render(float* out, unsigned long frames);
+
+private:
+    // The single-channel filter models of one output channel; only the selected one runs
+    struct FilterChannel {
+        explicit FilterChannel(float sampleRate) : biquad(sampleRate), svf(sampleRate) {}
+        LowPassFilter biquad;
+        StateVariableFilter svf;
+    };
+
+    // Apply one queued event to the DSP state
+    void applyEvent(const SynthEvent& event);
+
+    // Render at most RENDER_BLOCK_SIZE frames with no event in between
+    void renderSegment(float* out, unsigned long frames);
+
+    // Publish the block start position for frameTime()
+    void publishClock(unsigned long frames);
+
+    // Pass the snapshot's unsmoothed filter settings to every model of a channel
+    static void applyFilterParams(FilterChannel& channel, const SynthParams& snapshot);
+
+    // Pass the smoothed cutoff and resonance to every filter model
+    void applyFilterTone();
+
+    // Run the selected filter model over a sub-block in place (right is null for a mono mix)
+    void runFilters(float* left, float* right, int count);
+
+    // True once the selected filter model has rung out on both channels
+    bool filtersSettled() const;
+
+    // Stand-in for runFilters() over silence once settled
+    void skipFilters(int frames);
+
+    SynthParamsBuffer* params;                                     // UI parameter snapshots
+    SpscQueue<SynthEvent, SynthConstants::EVENT_QUEUE_SIZE> events; // Pending control events
+    NoteTableBuffer tunings;                                       // Note tables from setTuning()
+    VoicePool voices;                                              // Polyphonic voices (3 oscillators + envelope each)
+    FilterChannel filter;                                          // Filters (left, or both channels when mono)
+    FilterChannel filterRight;                                     // Right channel filters, only run for stereo voices
+    LadderFilter ladder;                                           // Ladder bank: lane 0 left (or mono), lane 1 right
+    FilterType filterType { FilterType::Biquad };                  // Model selected by the last snapshot
+    SmoothedValue volume { 0.0f, SmoothedValue::Curve::Linear };   // Output gain, smoothed per sample
+    SmoothedValue cutoff { 0.0f, SmoothedValue::Curve::OnePole };  // Filter cutoff, stepped once per grid block
+    SmoothedValue resonance { 0.0f, SmoothedValue::Curve::Linear }; // Filter resonance, stepped with the cutoff
+    float gains[SynthConstants::RENDER_BLOCK_SIZE];                // Smoothed volume of each frame in a sub-block
+    alignas(32) float buffer[SynthConstants::RENDER_BLOCK_SIZE];   // Scratch sub-block (left, or mono)
+    alignas(32) float bufferRight[SynthConstants::RENDER_BLOCK_SIZE]; // Right channel scratch sub-block
+    uint64_t frameCount { 0 };                                     // Frames rendered so far
+    bool chainSilent { false };                                    // Current grid block is skipped as silence
+    double sampleRate;                                             // Current sample rate in Hz
+
+    // Block clock for frameTime(), guarded by an even/odd sequence counter
+    std::atomic<uint32_t> clockSequence { 0 };
+    std::atomic<uint64_t> clockFrame { 0 };   // Frame at the start of the last block
+    std::atomic<int64_t> clockNanos { 0 };    // Steady clock time of that block start (0 = not running)
+    std::atomic<uint32_t> clockBlock { 0 };   // Size of the last block in frames
+    std::atomic<uint32_t> clockRate { 0 };    // Sample rate of that block in Hz
+};
+
+#endif // AUDIOSYNTH_SYNTHENGINE_H
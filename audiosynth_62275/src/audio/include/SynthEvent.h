@@ -0,0 +1,33 @@
+#ifndef AUDIOSYNTH_SYNTHEVENT_H
+#define AUDIOSYNTH_SYNTHEVENT_H
+
+#include <cstdint>
+
+// SynthEvent: a single change sent from a control thread to the audio thread
+// Events are the only way to modify DSP state owned by SynthEngine
+// Each event is stamped with the engine frame at which it must take effect;
+// the engine splits its render at that frame so timing is sample-accurate
+// Envelope, filter and volume settings are not events: they travel in SynthParams snapshots
+struct SynthEvent {
+    enum class Type {
+        NoteOn,                 // note = MIDI note, pitched by the engine's tuning table
+        NoteOff,                // note = MIDI note to release, -1 releases every voice
+        SetOscEnabled,          // oscillator = index, value = 0 or 1
+        SetOscWaveform,         // oscillator = index, value = Oscillator::Waveform
+        SetOscFrequencyOffset,  // oscillator = index, value = offset in semitones
+        SetOscUnison,           // oscillator = index, value = stacked copies (1 to MAX_UNISON)
+        SetOscUnisonDetune,     // oscillator = index, value = total detune in cents
+        SetOscUnisonSpread,     // oscillator = index, value = stereo spread (0 to 1)
+        SetOscModIndex,         // oscillator = modulator index (1 or 2), value = modulation index in radians
+        SetAlgorithm,           // value = TripleOscillator::Algorithm
+        SetSeed                 // value = noise seed, restarts the noise sequences
+    };
+
+    Type type;
+    int oscillator { 0 };  // Target oscillator (0-2) for per-oscillator events
+    double value { 0.0 };  // Event payload, meaning depends on type
+    uint64_t frame { 0 };  // Engine frame at which to apply (0 or past = immediately)
+    int note { -1 };       // MIDI note for NoteOn / NoteOff
+};
+
+#endif // AUDIOSYNTH_SYNTHEVENT_H
@@ -1,40 +1,57 @@
 #ifndef TESTINSTRUCT_SYNTHPARAMS_H
 #define TESTINSTRUCT_SYNTHPARAMS_H
 
-#include <mutex>
-
 // Structure to hold all synthesizer parameters
-// Protected by a mutex for thread-safe access
+// Plain value type: shared between threads as whole snapshots through SynthParamsBuffer
+// Note pitch is not stored here: the engine looks it up in its tuning table (see Tuning)
 struct SynthParams {
-    std::mutex mutex;
-    
-    // Base frequency parameters
-    double frequency { 440.0 };  // Base frequency in Hz
-    
     // Envelope parameters
     float attack { 0.1f };       // Envelope attack time in seconds
+    float decay { 0.1f };        // Envelope decay time in seconds
+    float sustain { 1.0f };      // Envelope sustain level (0.0 to 1.0)
     float release { 0.5f };      // Envelope release time in seconds
+    int envelope_curve { 0 };    // Envelope::Curve as int
     
     // Filter parameters
+    int filter_type { 0 };             // FilterType (0=Biquad low-pass, 1=State variable, 2=Ladder)
+    int filter_mode { 0 };             // StateVariableFilter::Mode (0=Low-pass, 1=High-pass, 2=Band-pass, 3=Notch, 4=Peak)
     float filter_cutoff { 20000.0f };  // Filter cutoff frequency in Hz
     float filter_resonance { 0.0f };   // Filter resonance (0.0 to 0.99)
     float filter_auto_variation_frequency { 10.0f };  // LFO frequency for filter cutoff modulation (Hz)
     float filter_auto_variation_amount { 0.0f };     // LFO amount for filter cutoff modulation (0.0 to 1.0)
+    float filter_drive { 1.0f };       // Ladder input drive into its saturation (1.0 to 10.0)
+    int filter_oversampling { 2 };     // Ladder oversampling factor (1, 2 or 4)
     
     // Volume parameter
     float volume { 1.0f };       // Master volume (0.0 to 1.0)
     
     // Oscillator parameters
-    int osc1_waveform { 0 };     // Oscillator 1 waveform (0=Sine, 1=Square, 2=Saw)
-    int osc2_waveform { 2 };     // Oscillator 2 waveform (0=Sine, 1=Square, 2=Saw)
-    int osc3_waveform { 1 };     // Oscillator 3 waveform (0=Sine, 1=Square, 2=Saw)
+    int osc1_waveform { 0 };     // Oscillator 1 waveform (Oscillator::Waveform: 0=Triangle, 1=Noise, 2=Saw, 3=Square, 4=Pulse, 5=Pink noise, 6=Brown noise)
+    int osc2_waveform { 2 };     // Oscillator 2 waveform (Oscillator::Waveform)
+    int osc3_waveform { 1 };     // Oscillator 3 waveform (Oscillator::Waveform)
     bool osc1_enabled { true };  // Oscillator 1 enabled state
     bool osc2_enabled { false }; // Oscillator 2 enabled state
     bool osc3_enabled { false }; // Oscillator 3 enabled state
     float osc1_frequency_offset { 0.0f };  // Oscillator 1 frequency offset in semitones
     float osc2_frequency_offset { 0.0f };  // Oscillator 2 frequency offset in semitones
     float osc3_frequency_offset { 0.0f };  // Oscillator 3 frequency offset in semitones
+    int osc1_unison { 1 };                 // Oscillator 1 unison copies (1 to SynthConstants::MAX_UNISON)
+    int osc2_unison { 1 };                 // Oscillator 2 unison copies
+    int osc3_unison { 1 };                 // Oscillator 3 unison copies
+    float osc1_unison_detune { 0.0f };     // Oscillator 1 total unison detune in cents
+    float osc2_unison_detune { 0.0f };     // Oscillator 2 total unison detune in cents
+    float osc3_unison_detune { 0.0f };     // Oscillator 3 total unison detune in cents
+    float osc1_unison_spread { 0.0f };     // Oscillator 1 unison stereo spread (0.0 to 1.0)
+    float osc2_unison_spread { 0.0f };     // Oscillator 2 unison stereo spread (0.0 to 1.0)
+    float osc3_unison_spread { 0.0f };     // Oscillator 3 unison stereo spread (0.0 to 1.0)
+    int fm_algorithm { 0 };                // TripleOscillator::Algorithm (0=Mix, 1=3>2>1, 2=2+3>1, 3=2>1 plus 3)
+    float osc2_mod_index { 1.0f };         // Oscillator 2 modulation index in radians (FM algorithms)
+    float osc3_mod_index { 1.0f };         // Oscillator 3 modulation index in radians (FM algorithms)
     
+    // Polyphony parameters
+    int voice_count { 8 };         // Voices available (1 to SynthConstants::MAX_VOICES)
+    int voice_steal_policy { 0 };  // VoiceStealPolicy (0=Oldest, 1=Quietest, 2=SameNote)
+
     // Mixing parameters
     float osc_mix { 0.5f };      // Mix between oscillators (0.0 to 1.0)
 };
@@ -0,0 +1,34 @@
+#ifndef AUDIOSYNTH_SYNTHPARAMSBUFFER_H
+#define AUDIOSYNTH_SYNTHPARAMSBUFFER_H
+
+#include <atomic>
+#include <cstdint>
+#include "SynthParams.h"
+
+// SynthParamsBuffer: wait-free triple buffer carrying SynthParams snapshots
+// from a single writer (GUI thread) to a single reader (audio thread).
+// Neither side ever blocks: the writer fills a private slot and swaps it with
+// the shared one, the reader swaps the shared slot in only when it is fresh.
+class SynthParamsBuffer {
+public:
+    // Constructor: all three slots start with default parameters
+    SynthParamsBuffer();
+
+    // Writer side: publish a complete parameter snapshot
+    void publish(const SynthParams& params);
+
+    // Reader side: return the most recently published snapshot
+    // The reference stays valid until the next call to read()
+    const SynthParams& read();
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;  // Slot index bits of 'shared'
+    static constexpr uint8_t FRESH_BIT = 0x4;   // Set when 'shared' holds an unread snapshot
+
+    SynthParams slots[3];              // Back (writer), shared and front (reader) slots
+    std::atomic<uint8_t> shared;       // Index of the shared slot plus FRESH_BIT
+    uint8_t writeIndex;                // Slot owned by the writer
+    uint8_t readIndex;                 // Slot owned by the reader
+};
+
+#endif // AUDIOSYNTH_SYNTHPARAMSBUFFER_H
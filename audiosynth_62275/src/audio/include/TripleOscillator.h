@@ -1,21 +1,32 @@
 // TripleOscillator class: combines three oscillators and an envelope
 // Provides a unified interface for controlling multiple oscillators with a single envelope
+// Not thread-safe: owned and driven by the audio thread only (see SynthEngine)
 
 
 #ifndef SIMPLE_SYNTH_TRIPLE_OSCILLATOR_H
 #define SIMPLE_SYNTH_TRIPLE_OSCILLATOR_H
 
-#include <mutex>
 #include "Oscillator.h"
 #include "Envelope.h"
 
 class TripleOscillator {
 public:
+    // How the three oscillators combine. The FM algorithms phase-modulate a carrier
+    // with the modulators' output; modulators are not heard themselves
+    enum class Algorithm {
+        Mix,    // osc1 + osc2 + osc3
+        Stack,  // osc3 -> osc2 -> osc1
+        Dual,   // osc2 + osc3 -> osc1
+        Split   // osc2 -> osc1, plus osc3
+    };
+
     // Constructor: initializes osc2 to Saw and osc3 to Noise waveform by default
     TripleOscillator();
 
     // Set base frequency for all oscillators
     void setFrequency(double freq);
+    // Same, as a phase increment per sample (2^32 = one cycle)
+    void setPhaseIncrement(double increment);
 
     // Enable/disable oscillators
     void setOsc1Enabled(bool enabled);
@@ -32,22 +43,66 @@ public:
     void setOsc2FrequencyOffset(float offset);
     void setOsc3FrequencyOffset(float offset);
 
+    // Set unison stack size, detune (cents) and stereo spread for each oscillator
+    void setOsc1Unison(int count);
+    void setOsc2Unison(int count);
+    void setOsc3Unison(int count);
+    void setOsc1UnisonDetune(float cents);
+    void setOsc2UnisonDetune(float cents);
+    void setOsc3UnisonDetune(float cents);
+    void setOsc1UnisonSpread(float spread);
+    void setOsc2UnisonSpread(float spread);
+    void setOsc3UnisonSpread(float spread);
+
+    // Choose how the oscillators combine
+    void setAlgorithm(Algorithm algorithm);
+
+    // Modulation index of the link from osc2 / osc3 to its carrier, in radians of
+    // phase deviation at full modulator level (0 to MAX_MODULATION_INDEX)
+    void setOsc2ModIndex(float index);
+    void setOsc3ModIndex(float index);
+
+    // True when a heard oscillator spreads a unison stack across the stereo field
+    bool isStereo() const;
+
     // Master envelope control methods
     void setAttack(float a);
+    void setDecay(float d);
+    void setSustain(float s);
     void setRelease(float r);
+    void setEnvelopeCurve(Envelope::Curve curve);
     void noteOn();
     void noteOff();
-    void setEnvSampleRate(float sr);
+
+    // Envelope state, used for voice allocation
+    float getLevel() const;
+    bool isActive() const;
+
+    // Set sample rate for all oscillators and the envelope
+    void setSampleRate(double sr);
+
+    // Seed the noise generators (each oscillator gets its own stream)
+    void setSeed(uint32_t seed);
 
     // Process a buffer of samples (size = bufferSize), combining all oscillators and applying the envelope
+    // Any size is accepted; work is done in sub-blocks of RENDER_BLOCK_SIZE samples
     void processBuffer(float* buffer, int bufferSize);
+    // Same, rendering left and right channels
+    void processBuffer(float* left, float* right, int bufferSize);
 
 private:
-    std::mutex mutex;  // Mutex to protect access to oscillators and envelope
+    // Render the current algorithm's output for one sub-block, before the envelope
+    // Specialized for mono (right unused) and stereo at compile time
+    template <bool Stereo>
+    void renderOscillators(float* left, float* right, int count);
+
     Oscillator osc1; // First oscillator
     Oscillator osc2; // Second oscillator
     Oscillator osc3; // Third oscillator
     Envelope env;     // Master amplitude envelope
+    Algorithm algorithm;  // How the oscillators combine
+    float modDepth2;      // osc2 -> carrier depth, in cycles per unit of modulator output
+    float modDepth3;      // osc3 -> carrier depth, same scale
 };
 
 #endif //SIMPLE_SYNTH_TRIPLE_OSCILLATOR_H
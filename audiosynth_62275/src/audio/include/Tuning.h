@@ -0,0 +1,60 @@
+#ifndef AUDIOSYNTH_TUNING_H
+#define AUDIOSYNTH_TUNING_H
+
+#include <array>
+#include <string>
+#include <vector>
+
+// Tuning: the frequency of every MIDI note, built from a scale and a keyboard mapping
+// Defaults to 12-tone equal temperament with A4 (note 69) at 440 Hz. Other tunings
+// load from Scala files: a scale (.scl, degrees in cents or ratios) and a keyboard
+// mapping (.kbm, which key plays which degree and the reference pitch)
+// The note table is rebuilt on load, so a lookup is one array read
+class Tuning {
+public:
+    static constexpr int NOTE_COUNT = 128;  // MIDI notes 0 to 127
+    using NoteTable = std::array<double, NOTE_COUNT>;  // Frequency of every note in Hz, 0 = silent
+
+    // Constructor: 12-tone equal temperament, A4 = 440 Hz
+    Tuning();
+
+    // Load a Scala scale (.scl); returns false and describes the problem in error
+    // The keyboard mapping is kept; on failure the tuning is unchanged
+    bool loadScale(const std::string& path, std::string& error);
+
+    // Load a Scala keyboard mapping (.kbm); returns false and describes the problem in error
+    // The scale is kept; on failure the tuning is unchanged
+    bool loadKeyboardMapping(const std::string& path, std::string& error);
+
+    // Back to 12-tone equal temperament with the default mapping
+    void reset();
+
+    // Frequency of a MIDI note in Hz, 0 for notes the mapping leaves silent
+    double frequency(int note) const;
+
+    // Frequency of every MIDI note, as frequency() gives them
+    const NoteTable& noteTable() const;
+
+private:
+    // Pitch of a scale degree in cents above degree 0, repeating every period
+    double degreeCents(int degree) const;
+
+    // Pitch of a note in cents above the middle note, false if the note is unmapped
+    bool noteCents(int note, double& cents) const;
+
+    // Recompute the note table from the scale and the mapping
+    void rebuild();
+
+    std::vector<double> scale;   // Degrees 1..n in cents above degree 0; the last one is the period
+    std::vector<int> mapping;    // Degree of each key in the repeating pattern, -1 = unmapped
+                                 // Empty = linear: every key plays the next degree
+    int firstNote;               // Lowest and highest notes that sound
+    int lastNote;
+    int middleNote;              // Note playing degree 0
+    int referenceNote;           // Note tuned to referenceFrequency
+    double referenceFrequency;   // In Hz
+    int octaveDegree;            // Degree one mapping pattern spans, 0 = the scale's period
+    NoteTable frequencies;
+};
+
+#endif // AUDIOSYNTH_TUNING_H
@@ -0,0 +1,124 @@
+#ifndef AUDIOSYNTH_VOICEPOOL_H
+#define AUDIOSYNTH_VOICEPOOL_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include "TripleOscillator.h"
+#include "Tuning.h"
+#include "SynthConstants.h"
+
+// Policy used when a note arrives and every voice is busy
+enum class VoiceStealPolicy {
+    Oldest,    // Steal the voice that started first (released voices go first)
+    Quietest,  // Steal the voice with the lowest envelope level
+    SameNote   // Retrigger the voice already playing this note, else steal the oldest
+};
+
+// VoicePool: polyphonic voice allocation over a fixed pool of voices
+// Each voice is a TripleOscillator (3 oscillators + its own envelope).
+// Allocation state is kept as a structure of arrays so the per-note scans and
+// the per-block active-voice walk touch a few contiguous arrays, not every voice.
+// The per-voice DSP state (phases, increments, envelope) stays inside each voice:
+// a voice renders a whole sub-block at a time, vectorized across samples and unison
+// copies (see OscillatorKernels), so its state is only touched once per block.
+// Not thread-safe: owned and driven by the audio thread only (see SynthEngine)
+class VoicePool {
+public:
+    // Constructor: all voices idle, full pool in use, oldest-voice stealing
+    VoicePool();
+
+    // Number of voices available for allocation (1 to MAX_VOICES)
+    // Voices above the new count are released and ring out through their envelope
+    void setVoiceCount(int count);
+    int getVoiceCount() const;
+
+    // Choose how voices are stolen when the pool is full
+    void setStealPolicy(VoiceStealPolicy policy);
+
+    // Start a note on a free (or stolen) voice, pitched from the tuning table
+    // Notes the tuning leaves unmapped, or pitches above the Nyquist frequency, are ignored
+    void noteOn(int note);
+    // Release every voice playing this note
+    void noteOff(int note);
+    // Release every voice
+    void allNotesOff();
+
+    // Settings applied to every voice
+    void setOscEnabled(int osc, bool enabled);
+    void setOscWaveform(int osc, Oscillator::Waveform wf);
+    void setOscFrequencyOffset(int osc, float offset);
+    void setOscUnison(int osc, int count);
+    void setOscUnisonDetune(int osc, float cents);
+    void setOscUnisonSpread(int osc, float spread);
+    void setOscModIndex(int osc, float index);
+    void setAlgorithm(TripleOscillator::Algorithm algorithm);
+    void setAttack(float a);
+    void setDecay(float d);
+    void setSustain(float s);
+    void setRelease(float r);
+    void setEnvelopeCurve(Envelope::Curve curve);
+    void setSampleRate(double sr);
+    void setSeed(uint32_t seed);
+
+    // Pitch of every MIDI note; rebuilds the per-note phase increment table
+    void setNoteFrequencies(const Tuning::NoteTable& frequencies);
+
+    // Number of voices currently sounding (held or releasing)
+    int getActiveVoiceCount() const;
+
+    // True when no voice is sounding: every envelope is idle, so rendering would give silence
+    bool isIdle() const;
+
+    // True when the voices render different left and right channels (unison spread)
+    // Settings are shared by every voice, so this holds for all of them or none
+    bool isStereo() const;
+
+    // Free the voices whose envelope has finished
+    // SynthEngine calls it at the start of each grid block, so where a finished voice stops
+    // (and the oscillator phases it keeps when reused) does not depend on the host buffer size
+    void retireFinishedVoices();
+
+    // Render and sum all sounding voices into buffer (bufferSize <= RENDER_BLOCK_SIZE)
+    void processBuffer(float* buffer, int bufferSize);
+    // Same, into left and right channels
+    void processBuffer(float* left, float* right, int bufferSize);
+
+private:
+    // Pick the voice for a new note: same note, then idle voice, then steal
+    int allocate(int note) const;
+
+    // Recompute the phase increment of every note at the current sample rate
+    void updateNoteIncrements();
+
+    static constexpr int MAX = SynthConstants::MAX_VOICES;
+
+    std::array<TripleOscillator, MAX> voices;  // Per-voice DSP state
+
+    // Structure of arrays: one entry per voice
+    std::array<int, MAX> notes;          // MIDI note, -1 when never used
+    std::array<uint64_t, MAX> startedAt; // Allocation order, for oldest-voice stealing
+    std::array<float, MAX> levels;       // Envelope level at the end of the last block
+    std::array<uint8_t, MAX> gates;      // 1 while the key is held
+    std::array<uint8_t, MAX> active;     // 1 while held or releasing
+
+    int voiceCount;
+    int renderCount;   // Voices walked when rendering: voiceCount, plus any above it still releasing
+    VoiceStealPolicy stealPolicy;
+    uint64_t allocationCounter;
+
+    // Tuning table: one entry per MIDI note
+    Tuning::NoteTable noteFrequencies;                       // In Hz, 0 = unmapped
+    std::array<double, Tuning::NOTE_COUNT> noteIncrements;   // Phase increment per sample, 2^32 = one cycle
+    double sampleRate;
+
+    // Envelope settings last applied to every voice (NaN = never): the engine re-applies
+    // its snapshot each block, so unchanged values skip the walk over the pool
+    float attack = std::numeric_limits<float>::quiet_NaN();
+    float decay = std::numeric_limits<float>::quiet_NaN();
+    float sustain = std::numeric_limits<float>::quiet_NaN();
+    float release = std::numeric_limits<float>::quiet_NaN();
+    int envelopeCurve = -1;
+};
+
+#endif // AUDIOSYNTH_VOICEPOOL_H
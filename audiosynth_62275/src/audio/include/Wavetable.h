@@ -0,0 +1,49 @@
+// Wavetable.h
+// Band-limited, mip-mapped single-cycle tables shared by every oscillator
+
+
+#ifndef AUDIOSYNTH_WAVETABLE_H
+#define AUDIOSYNTH_WAVETABLE_H
+
+#include <vector>
+
+// Wavetable bank: one table per shape and octave, built once and then read-only
+// Level k holds at most (MAX_HARMONICS >> k) harmonics, so a note reads the
+// richest level whose top harmonic still stays below Nyquist.
+// Tables depend only on the phase step (cycles per sample), not on the sample rate.
+class Wavetable {
+public:
+    // Shapes held in the bank
+    enum class Shape {
+        Triangle,
+        Saw,
+        Square,
+        Pulse,   // 25% duty cycle, DC removed
+        Count
+    };
+
+    static constexpr int TABLE_BITS = 11;                  // Top phase bits used as table index
+    static constexpr int TABLE_SIZE = 1 << TABLE_BITS;     // Samples per cycle
+    static constexpr int MAX_HARMONICS = TABLE_SIZE / 2;   // Harmonics in level 0
+    static constexpr int LEVELS = 11;                      // Down to a single harmonic
+    static constexpr int TABLE_STRIDE = TABLE_SIZE + 2;    // Plus guard samples (index + 1 never wraps)
+
+    // The shared bank, built on first use
+    // Oscillator's constructor touches it so the build never happens on the audio thread
+    static const Wavetable& instance();
+
+    // Table for a shape, band-limited for the given phase step (cycles per sample)
+    const float* select(Shape shape, double phaseStep) const;
+    // Tables are read with linear interpolation by OscillatorKernels
+
+private:
+    // Build every level of every shape by additive synthesis
+    Wavetable();
+
+    // Start of one table: [shape][level][TABLE_STRIDE]
+    float* table(Shape shape, int level);
+
+    std::vector<float> tables;
+};
+
+#endif // AUDIOSYNTH_WAVETABLE_H
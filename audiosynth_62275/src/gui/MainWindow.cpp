@@ -8,7 +8,6 @@
 #include "imgui_impl_sdl3.h"
 #include "imgui_impl_sdlrenderer3.h"
 #include <cmath>
-#include <mutex>
 
 // Target framerate for smooth UI
 constexpr float FRAMERATE = 60.0f;
@@ -24,7 +23,7 @@ void MainWindow::init() {
     }
     // Create a hidden window that we'll show later
     Uint32 window_flags = SDL_WINDOW_HIDDEN;
-    window = SDL_CreateWindow("synth", 584, 868, window_flags);
+    window = SDL_CreateWindow("synth", 584, 1500, window_flags);
     if (nullptr == window) {
         SDL_Log("Error: SDL_CreateWindow(): %s\n", SDL_GetError());
         return;
@@ -63,17 +62,21 @@ void MainWindow::init() {
         audioGenerator->setOsc1FrequencyOffset(osc1_freq_offset);
         audioGenerator->setOsc2FrequencyOffset(osc2_freq_offset);
         audioGenerator->setOsc3FrequencyOffset(osc3_freq_offset);
+        audioGenerator->setOsc1Unison(osc1_unison);
+        audioGenerator->setOsc2Unison(osc2_unison);
+        audioGenerator->setOsc3Unison(osc3_unison);
+        audioGenerator->setOsc1UnisonDetune(osc1_unison_detune);
+        audioGenerator->setOsc2UnisonDetune(osc2_unison_detune);
+        audioGenerator->setOsc3UnisonDetune(osc3_unison_detune);
+        audioGenerator->setOsc1UnisonSpread(osc1_unison_spread);
+        audioGenerator->setOsc2UnisonSpread(osc2_unison_spread);
+        audioGenerator->setOsc3UnisonSpread(osc3_unison_spread);
+        audioGenerator->setAlgorithm(static_cast<TripleOscillator::Algorithm>(fm_algorithm));
+        audioGenerator->setOsc2ModIndex(osc2_mod_index);
+        audioGenerator->setOsc3ModIndex(osc3_mod_index);
     }
     
-    if (params) {
-        std::lock_guard<std::mutex> lock(params->mutex);
-        params->attack = attack_time;
-        params->release = release_time;
-        params->filter_cutoff = filter_cutoff;
-        params->filter_resonance = filter_resonance;
-
-        params->volume = volume;
-    }
+    publishParams();
 }
 
 // Main application loop
@@ -94,6 +97,10 @@ void MainWindow::run() {
                 && (SDL_GetWindowID(window) == event.window.windowID))
                 done = true;
         }
+        // Notes the audio thread had no room for get another go each frame
+        if (audioGenerator) {
+            audioGenerator->flushPendingNotes();
+        }
         // Start new ImGui frame
         ImGui_ImplSDLRenderer3_NewFrame();
         ImGui_ImplSDL3_NewFrame();
@@ -140,7 +147,7 @@ void MainWindow::draw() {
     ImGui::Spacing();
     ImGui::Checkbox("Oscillator 1", &osc1_enabled);
     ImGui::Text("OSC 1 Waveform");
-    const char* waveforms[] = { "Triangle", "Noise", "Saw" };
+    const char* waveforms[] = { "Triangle", "Noise", "Saw", "Square", "Pulse", "Pink Noise", "Brown Noise" };
     ImGui::SetNextItemWidth(window_width - 40);
     if (ImGui::Combo("##osc1_waveform", &osc1_waveform, waveforms, IM_ARRAYSIZE(waveforms)) && audioGenerator) {
         audioGenerator->setOsc1Waveform(static_cast<Oscillator::Waveform>(osc1_waveform));
@@ -150,6 +157,21 @@ void MainWindow::draw() {
     if (ImGui::SliderFloat("##freq_offset_osc1", &osc1_freq_offset, -5.0f, 5.0f, "%.3f") && audioGenerator) {
         audioGenerator->setOsc1FrequencyOffset(osc1_freq_offset);
     }
+    ImGui::Text("OSC 1 Unison / Detune / Spread");
+    ImGui::SetNextItemWidth((window_width - 56) / 3);
+    if (ImGui::SliderInt("##unison_osc1", &osc1_unison, 1, SynthConstants::MAX_UNISON) && audioGenerator) {
+        audioGenerator->setOsc1Unison(osc1_unison);
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth((window_width - 56) / 3);
+    if (ImGui::SliderFloat("##unison_detune_osc1", &osc1_unison_detune, 0.0f, 100.0f, "%.1f ct") && audioGenerator) {
+        audioGenerator->setOsc1UnisonDetune(osc1_unison_detune);
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth((window_width - 56) / 3);
+    if (ImGui::SliderFloat("##unison_spread_osc1", &osc1_unison_spread, 0.0f, 1.0f, "%.2f") && audioGenerator) {
+        audioGenerator->setOsc1UnisonSpread(osc1_unison_spread);
+    }
     ImGui::Spacing();
 
 
@@ -166,6 +188,21 @@ void MainWindow::draw() {
     if (ImGui::SliderFloat("##freq_offset_osc2", &osc2_freq_offset, -5.0f, 5.0f, "%.3f") && audioGenerator) {
         audioGenerator->setOsc2FrequencyOffset(osc2_freq_offset);
     }
+    ImGui::Text("OSC 2 Unison / Detune / Spread");
+    ImGui::SetNextItemWidth((window_width - 56) / 3);
+    if (ImGui::SliderInt("##unison_osc2", &osc2_unison, 1, SynthConstants::MAX_UNISON) && audioGenerator) {
+        audioGenerator->setOsc2Unison(osc2_unison);
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth((window_width - 56) / 3);
+    if (ImGui::SliderFloat("##unison_detune_osc2", &osc2_unison_detune, 0.0f, 100.0f, "%.1f ct") && audioGenerator) {
+        audioGenerator->setOsc2UnisonDetune(osc2_unison_detune);
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth((window_width - 56) / 3);
+    if (ImGui::SliderFloat("##unison_spread_osc2", &osc2_unison_spread, 0.0f, 1.0f, "%.2f") && audioGenerator) {
+        audioGenerator->setOsc2UnisonSpread(osc2_unison_spread);
+    }
     ImGui::Spacing();
 
 
@@ -182,7 +219,41 @@ void MainWindow::draw() {
     if (ImGui::SliderFloat("##freq_offset_osc3", &osc3_freq_offset, -5.0f, 5.0f, "%.3f") && audioGenerator) {
         audioGenerator->setOsc3FrequencyOffset(osc3_freq_offset);
     }
+    ImGui::Text("OSC 3 Unison / Detune / Spread");
+    ImGui::SetNextItemWidth((window_width - 56) / 3);
+    if (ImGui::SliderInt("##unison_osc3", &osc3_unison, 1, SynthConstants::MAX_UNISON) && audioGenerator) {
+        audioGenerator->setOsc3Unison(osc3_unison);
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth((window_width - 56) / 3);
+    if (ImGui::SliderFloat("##unison_detune_osc3", &osc3_unison_detune, 0.0f, 100.0f, "%.1f ct") && audioGenerator) {
+        audioGenerator->setOsc3UnisonDetune(osc3_unison_detune);
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth((window_width - 56) / 3);
+    if (ImGui::SliderFloat("##unison_spread_osc3", &osc3_unison_spread, 0.0f, 1.0f, "%.2f") && audioGenerator) {
+        audioGenerator->setOsc3UnisonSpread(osc3_unison_spread);
+    }
+    ImGui::Spacing();
+
+    // FM algorithm and modulation indices
     ImGui::Spacing();
+    ImGui::Text("Algorithm");
+    const char* algorithms[] = { "Mix (1 + 2 + 3)", "FM 3 > 2 > 1", "FM 2 + 3 > 1", "FM 2 > 1, plus 3" };
+    ImGui::SetNextItemWidth(window_width - 40);
+    if (ImGui::Combo("##fm_algorithm", &fm_algorithm, algorithms, IM_ARRAYSIZE(algorithms)) && audioGenerator) {
+        audioGenerator->setAlgorithm(static_cast<TripleOscillator::Algorithm>(fm_algorithm));
+    }
+    ImGui::Text("OSC 2 / OSC 3 Modulation Index");
+    ImGui::SetNextItemWidth((window_width - 48) / 2);
+    if (ImGui::SliderFloat("##mod_index_osc2", &osc2_mod_index, 0.0f, SynthConstants::MAX_MODULATION_INDEX, "%.2f") && audioGenerator) {
+        audioGenerator->setOsc2ModIndex(osc2_mod_index);
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth((window_width - 48) / 2);
+    if (ImGui::SliderFloat("##mod_index_osc3", &osc3_mod_index, 0.0f, SynthConstants::MAX_MODULATION_INDEX, "%.2f") && audioGenerator) {
+        audioGenerator->setOsc3ModIndex(osc3_mod_index);
+    }
     ImGui::Spacing();
     ImGui::Spacing();
     ImGui::Separator();
@@ -194,53 +265,91 @@ void MainWindow::draw() {
     // Envelope controls
     ImGui::Text("Attack");
     ImGui::SetNextItemWidth(window_width - 40);
-    if (ImGui::SliderFloat("##attack", &attack_time, 0.0f, 1.0f, "%.3f") && params) {
-        std::lock_guard<std::mutex> lock(params->mutex);
-        params->attack = attack_time;
+    if (ImGui::SliderFloat("##attack", &attack_time, 0.0f, 1.0f, "%.3f")) {
+        publishParams();
+    }
+    ImGui::Text("Decay / Sustain");
+    ImGui::SetNextItemWidth((window_width - 48) / 2);
+    if (ImGui::SliderFloat("##decay", &decay_time, 0.0f, 1.0f, "%.3f")) {
+        publishParams();
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth((window_width - 48) / 2);
+    if (ImGui::SliderFloat("##sustain", &sustain_level, 0.0f, 1.0f, "%.3f")) {
+        publishParams();
     }
     ImGui::Text("Release");
     ImGui::SetNextItemWidth(window_width - 40);
-    if (ImGui::SliderFloat("##release", &release_time, 0.0f, 1.0f, "%.3f") && params) {
-        std::lock_guard<std::mutex> lock(params->mutex);
-        params->release = release_time;
+    if (ImGui::SliderFloat("##release", &release_time, 0.0f, 1.0f, "%.3f")) {
+        publishParams();
+    }
+    ImGui::Text("Envelope Curve");
+    const char* envelope_curves[] = { "Linear", "Exponential" };
+    ImGui::SetNextItemWidth(window_width - 40);
+    if (ImGui::Combo("##envelope_curve", &envelope_curve, envelope_curves, IM_ARRAYSIZE(envelope_curves))) {
+        publishParams();
     }
 
     // Filter controls
+    ImGui::Text("Filter Type / Mode");
+    const char* filter_types[] = { "Biquad low-pass", "State variable", "Ladder" };
+    ImGui::SetNextItemWidth((window_width - 48) / 2);
+    if (ImGui::Combo("##filter_type", &filter_type, filter_types, IM_ARRAYSIZE(filter_types))) {
+        publishParams();
+    }
+    ImGui::SameLine();
+    // Only the state-variable filter has modes
+    const char* filter_modes[] = { "Low-pass", "High-pass", "Band-pass", "Notch", "Peak" };
+    ImGui::BeginDisabled(filter_type != static_cast<int>(FilterType::StateVariable));
+    ImGui::SetNextItemWidth((window_width - 48) / 2);
+    if (ImGui::Combo("##filter_mode", &filter_mode, filter_modes, IM_ARRAYSIZE(filter_modes))) {
+        publishParams();
+    }
+    ImGui::EndDisabled();
+    // Drive and oversampling only apply to the ladder
+    ImGui::BeginDisabled(filter_type != static_cast<int>(FilterType::Ladder));
+    ImGui::Text("Ladder Drive / Oversampling");
+    ImGui::SetNextItemWidth((window_width - 48) / 2);
+    if (ImGui::SliderFloat("##filter_drive", &filter_drive, 1.0f, 10.0f, "%.2f")) {
+        publishParams();
+    }
+    ImGui::SameLine();
+    const char* oversampling_factors[] = { "1x", "2x", "4x" };
+    ImGui::SetNextItemWidth((window_width - 48) / 2);
+    if (ImGui::Combo("##filter_oversampling", &filter_oversampling_index, oversampling_factors, IM_ARRAYSIZE(oversampling_factors))) {
+        publishParams();
+    }
+    ImGui::EndDisabled();
     ImGui::Text("Filter Cutoff");
     ImGui::SetNextItemWidth(window_width - 40);
-    if (ImGui::SliderFloat("##filter_cutoff", &filter_cutoff, 20.0f, 20000.0f, "%.3f") && params) {
-        std::lock_guard<std::mutex> lock(params->mutex);
-        params->filter_cutoff = filter_cutoff;
+    if (ImGui::SliderFloat("##filter_cutoff", &filter_cutoff, 20.0f, 20000.0f, "%.3f")) {
+        publishParams();
     }
     ImGui::Text("Filter Resonance");
     ImGui::SetNextItemWidth(window_width - 40);
-    if (ImGui::SliderFloat("##filter_resonance", &filter_resonance, 0.0f, 0.99f, "%.3f") && params) {
-        std::lock_guard<std::mutex> lock(params->mutex);
-        params->filter_resonance = filter_resonance;
+    if (ImGui::SliderFloat("##filter_resonance", &filter_resonance, 0.0f, 0.99f, "%.3f")) {
+        publishParams();
     }
     
     // Filter LFO controls
     ImGui::Text("Filter Auto-Variation Frequency");
     ImGui::SetNextItemWidth(window_width - 40);
-    if (ImGui::SliderFloat("##filter_auto_variation_frequency", &filter_auto_variation_frequency, 1.0f, 20.0f, "%.2f Hz") && params) {
-        std::lock_guard<std::mutex> lock(params->mutex);
-        params->filter_auto_variation_frequency = filter_auto_variation_frequency;
+    if (ImGui::SliderFloat("##filter_auto_variation_frequency", &filter_auto_variation_frequency, 1.0f, 20.0f, "%.2f Hz")) {
+        publishParams();
     }
     
     ImGui::Text("Filter Auto-Variation Amount");
     ImGui::SetNextItemWidth(window_width - 40);
-    if (ImGui::SliderFloat("##filter_auto_variation_amount", &filter_auto_variation_amount, 0.0f, 1.0f, "%.2f") && params) {
-        std::lock_guard<std::mutex> lock(params->mutex);
-        params->filter_auto_variation_amount = filter_auto_variation_amount;
+    if (ImGui::SliderFloat("##filter_auto_variation_amount", &filter_auto_variation_amount, 0.0f, 1.0f, "%.2f")) {
+        publishParams();
     }
 
 
     // Volume control
     ImGui::Text("Volume");
     ImGui::SetNextItemWidth(window_width - 40);
-    if (ImGui::SliderFloat("##volume", &volume, 0.0f, 1.0f, "%.3f") && params) {
-        std::lock_guard<std::mutex> lock(params->mutex);
-        params->volume = volume;
+    if (ImGui::SliderFloat("##volume", &volume, 0.0f, 1.0f, "%.3f")) {
+        publishParams();
     }
 
     // Octave control
@@ -260,6 +369,71 @@ void MainWindow::draw() {
         if (octave < 1) octave++;
     }
     ImGui::PopStyleColor(3);
+
+    // Polyphony controls
+    ImGui::Text("Voices");
+    ImGui::SetNextItemWidth(window_width - 40);
+    if (ImGui::SliderInt("##voice_count", &voice_count, 1, SynthConstants::MAX_VOICES)) {
+        publishParams();
+    }
+    ImGui::Text("Voice Stealing");
+    const char* steal_policies[] = { "Oldest", "Quietest", "Same note" };
+    ImGui::SetNextItemWidth(window_width - 40);
+    if (ImGui::Combo("##voice_steal_policy", &voice_steal_policy, steal_policies, IM_ARRAYSIZE(steal_policies))) {
+        publishParams();
+    }
+
+    // Audio stream controls: switching reopens the stream at the new rate / buffer size
+    ImGui::Text("Sample Rate");
+    const char* sample_rates[] = { "44.1 kHz", "48 kHz", "96 kHz", "192 kHz" };
+    const char* latency_profiles[] = { "Low latency", "Balanced", "Power save" };
+    ImGui::SetNextItemWidth(window_width - 40);
+    bool audio_changed = ImGui::Combo("##sample_rate", &sample_rate_index, sample_rates, IM_ARRAYSIZE(sample_rates));
+    ImGui::Text("Latency");
+    ImGui::SetNextItemWidth(window_width - 40);
+    audio_changed |= ImGui::Combo("##latency_profile", &latency_profile, latency_profiles, IM_ARRAYSIZE(latency_profiles));
+    if (audio_changed && audioGenerator) {
+        AudioConfig config;
+        config.sampleRate = SynthConstants::SUPPORTED_SAMPLE_RATES[sample_rate_index];
+        config.latency = static_cast<LatencyProfile>(latency_profile);
+        if (!audioGenerator->setAudioConfig(config)) {
+            // Device refused the configuration: show the one still in use
+            setAudioGenerator(audioGenerator);
+        }
+    }
+
+    // Tuning: Scala scale and keyboard mapping, either may be left empty
+    // Loading hands the note table over with the stream stopped, like a rate change
+    ImGui::Text("Tuning (Scala .scl / .kbm)");
+    ImGui::SetNextItemWidth((window_width - 48) / 2);
+    ImGui::InputTextWithHint("##scale_path", "scale.scl", scale_path, sizeof(scale_path));
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth((window_width - 48) / 2);
+    ImGui::InputTextWithHint("##keyboard_map_path", "mapping.kbm", keyboard_map_path, sizeof(keyboard_map_path));
+    ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(1.0f, 1.0f, 1.0f, 1.0f));
+    ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.8f, 0.71f, 0.49f, 1.0f));
+    ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.6f, 0.51f, 0.29f, 1.0f));
+    if (ImGui::Button("Load tuning", ImVec2(100, 20)) && audioGenerator) {
+        Tuning tuning;
+        std::string error;
+        if ((scale_path[0] && !tuning.loadScale(scale_path, error))
+            || (keyboard_map_path[0] && !tuning.loadKeyboardMapping(keyboard_map_path, error))) {
+            tuning_status = error;
+        } else {
+            audioGenerator->setTuning(tuning);
+            tuning_status = "Tuning loaded";
+        }
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("12-TET", ImVec2(60, 20)) && audioGenerator) {
+        audioGenerator->setTuning(Tuning());
+        tuning_status = "12-tone equal temperament";
+    }
+    ImGui::PopStyleColor(3);
+    if (!tuning_status.empty()) {
+        ImGui::SameLine();
+        ImGui::TextUnformatted(tuning_status.c_str());
+    }
     
     ImGui::Spacing();
     ImGui::Spacing();
@@ -283,21 +457,15 @@ void MainWindow::draw() {
         ImGuiKey_Y, ImGuiKey_H, ImGuiKey_U, ImGuiKey_J, ImGuiKey_I, ImGuiKey_K,
         ImGuiKey_L
     };
-    static int noteActive = -1;
     ImGuiIO& io = ImGui::GetIO();
 
-    // Handle keyboard input
+    // Handle keyboard input: every held key sounds its own voice
     for (int i = 0; i < 13; ++i) {
         if (ImGui::IsKeyPressed(keymap[i], false)) {
-            if (noteActive != i) {
-                handleKeyRelease();
-                handleKeyPress(i+1);
-                noteActive = i;
-            }
+            handleKeyPress(i+1);
         }
-        if (ImGui::IsKeyReleased(keymap[i]) && noteActive == i) {
-            handleKeyRelease();
-            noteActive = -1;
+        if (ImGui::IsKeyReleased(keymap[i])) {
+            handleKeyRelease(i+1);
         }
     }
 
@@ -310,14 +478,14 @@ void MainWindow::draw() {
         bool pressed = ImGui::Button(label, ImVec2(button_size, button_size));
         bool held = ImGui::IsItemActive();
         bool released = ImGui::IsItemDeactivated();
-        if ((pressed || held) && noteActive != i-1) {
-            handleKeyRelease();
+        if ((pressed || held) && mouse_key != i) {
+            handleKeyRelease(mouse_key);
             handleKeyPress(i);
-            noteActive = i-1;
+            mouse_key = i;
         }
-        if (released && noteActive == i-1) {
-            handleKeyRelease();
-            noteActive = -1;
+        if (released && mouse_key == i) {
+            handleKeyRelease(i);
+            mouse_key = 0;
         }
     }
     ImGui::PopStyleColor();
@@ -328,34 +496,88 @@ void MainWindow::draw() {
 // Handle note press events
 // Called when a key is pressed on the piano keyboard
 void MainWindow::handleKeyPress(int key) {
-    if (key >= 1 && key <= 13 && audioGenerator && params) {
+    if (key >= 1 && key <= 13 && audioGenerator && params && playing_notes[key-1] < 0) {
         int noteNumber = key - 1;
-        double freq = AudioGenerator::calculateNoteFrequency(noteNumber, octave);
-        {
-            std::lock_guard<std::mutex> lock(params->mutex);
-            params->frequency = freq;
-        }
         audioGenerator->setOsc1Enabled(osc1_enabled);
         audioGenerator->setOsc2Enabled(osc2_enabled);
         audioGenerator->setOsc3Enabled(osc3_enabled);
-        audioGenerator->noteOn();
+        // Remember the note so an octave change while held still releases it
+        playing_notes[key-1] = AudioGenerator::calculateMidiNote(noteNumber, octave);
+        audioGenerator->noteOn(playing_notes[key-1]);
     }
 }
 
 // Handle note release events
 // Called when a key is released on the piano keyboard
-void MainWindow::handleKeyRelease() {
-    if (audioGenerator) {
-        audioGenerator->noteOff();
+void MainWindow::handleKeyRelease(int key) {
+    if (key >= 1 && key <= 13 && audioGenerator && playing_notes[key-1] >= 0) {
+        audioGenerator->noteOff(playing_notes[key-1]);
+        playing_notes[key-1] = -1;
     }
 }
 
 // Set the audio generator instance
 void MainWindow::setAudioGenerator(AudioGenerator* audio) {
     audioGenerator = audio;
+    if (audioGenerator) {
+        // Mirror the stream configuration in the audio controls
+        const AudioConfig& config = audioGenerator->getAudioConfig();
+        for (int i = 0; i < IM_ARRAYSIZE(SynthConstants::SUPPORTED_SAMPLE_RATES); i++) {
+            if (SynthConstants::SUPPORTED_SAMPLE_RATES[i] == config.sampleRate) {
+                sample_rate_index = i;
+            }
+        }
+        latency_profile = static_cast<int>(config.latency);
+    }
 }
 
-// Set the synthesizer parameters
-void MainWindow::setSynthParams(SynthParams* p) {
+// Set the synthesizer parameter buffer the UI publishes to
+void MainWindow::setSynthParams(SynthParamsBuffer* p) {
     params = p;
 }
+
+// Publish the current UI parameter values as one snapshot to the audio thread
+// Wait-free: the audio callback never waits for the UI while we write
+void MainWindow::publishParams() {
+    if (!params) return;
+    SynthParams snapshot;
+    snapshot.attack = attack_time;
+    snapshot.decay = decay_time;
+    snapshot.sustain = sustain_level;
+    snapshot.release = release_time;
+    snapshot.envelope_curve = envelope_curve;
+    snapshot.filter_type = filter_type;
+    snapshot.filter_mode = filter_mode;
+    snapshot.filter_drive = filter_drive;
+    snapshot.filter_oversampling = 1 << filter_oversampling_index;
+    snapshot.filter_cutoff = filter_cutoff;
+    snapshot.filter_resonance = filter_resonance;
+    snapshot.filter_auto_variation_frequency = filter_auto_variation_frequency;
+    snapshot.filter_auto_variation_amount = filter_auto_variation_amount;
+    snapshot.volume = volume;
+    snapshot.osc1_waveform = osc1_waveform;
+    snapshot.osc2_waveform = osc2_waveform;
+    snapshot.osc3_waveform = osc3_waveform;
+    snapshot.osc1_enabled = osc1_enabled;
+    snapshot.osc2_enabled = osc2_enabled;
+    snapshot.osc3_enabled = osc3_enabled;
+    snapshot.osc1_frequency_offset = osc1_freq_offset;
+    snapshot.osc2_frequency_offset = osc2_freq_offset;
+    snapshot.osc3_frequency_offset = osc3_freq_offset;
+    snapshot.osc1_unison = osc1_unison;
+    snapshot.osc2_unison = osc2_unison;
+    snapshot.osc3_unison = osc3_unison;
+    snapshot.osc1_unison_detune = osc1_unison_detune;
+    snapshot.osc2_unison_detune = osc2_unison_detune;
+    snapshot.osc3_unison_detune = osc3_unison_detune;
+    snapshot.osc1_unison_spread = osc1_unison_spread;
+    snapshot.osc2_unison_spread = osc2_unison_spread;
+    snapshot.osc3_unison_spread = osc3_unison_spread;
+    snapshot.fm_algorithm = fm_algorithm;
+    snapshot.osc2_mod_index = osc2_mod_index;
+    snapshot.osc3_mod_index = osc3_mod_index;
+    snapshot.osc_mix = osc_mix;
+    snapshot.voice_count = voice_count;
+    snapshot.voice_steal_policy = voice_steal_policy;
+    params->publish(snapshot);
+}
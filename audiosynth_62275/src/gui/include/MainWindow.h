@@ -2,8 +2,9 @@
 #define TESTINSTRUCT_MAINWINDOW_H
 
 #include <SDL3/SDL.h>
+#include <string>
 #include "../../audio/include/AudioGenerator.h"
-#include "../../audio/include/SynthParams.h"
+#include "../../audio/include/SynthParamsBuffer.h"
 
 // Main window class that handles the synthesizer's GUI
 class MainWindow {
@@ -12,11 +13,22 @@ public:
     MainWindow() : window(nullptr), renderer(nullptr), audioGenerator(nullptr),
                   osc1_enabled(true), osc2_enabled(false), osc3_enabled(false),
                   osc1_waveform(0), osc2_waveform(2), osc3_waveform(1),
-                  osc1_freq_offset(0.0f), osc2_freq_offset(0.0f), osc3_freq_offset(0.0f), osc_mix(0.5f), params(nullptr),
-                  attack_time(0.5f), release_time(1.0f),
+                  osc1_freq_offset(0.0f), osc2_freq_offset(0.0f), osc3_freq_offset(0.0f),
+                  osc1_unison(1), osc2_unison(1), osc3_unison(1),
+                  osc1_unison_detune(0.0f), osc2_unison_detune(0.0f), osc3_unison_detune(0.0f),
+                  osc1_unison_spread(0.0f), osc2_unison_spread(0.0f), osc3_unison_spread(0.0f),
+                  fm_algorithm(0), osc2_mod_index(1.0f), osc3_mod_index(1.0f), osc_mix(0.5f), params(nullptr),
+                  attack_time(0.5f), decay_time(0.1f), sustain_level(1.0f), release_time(1.0f), envelope_curve(0),
+                  filter_type(0), filter_mode(0), filter_drive(1.0f), filter_oversampling_index(1),
                   filter_cutoff(20000.0f), filter_resonance(0.0f),
                   filter_auto_variation_frequency(10.0f), filter_auto_variation_amount(0.0f),
-                  volume(1.0f), isNotePlaying(false), octave(0) {}
+                  volume(1.0f), isNotePlaying(false), octave(0),
+                  sample_rate_index(0), latency_profile(1),
+                  voice_count(8), voice_steal_policy(0), mouse_key(0) {
+        for (int& note : playing_notes) note = -1;
+        scale_path[0] = '\0';
+        keyboard_map_path[0] = '\0';
+    }
 
     // Initialize the window and GUI components
     void init();
@@ -26,14 +38,14 @@ public:
     void draw();
     // Set the audio generator instance
     void setAudioGenerator(AudioGenerator* audio);
-    // Set the synthesizer parameters
-    void setSynthParams(SynthParams* p);
+    // Set the synthesizer parameter buffer the UI publishes to
+    void setSynthParams(SynthParamsBuffer* p);
 
 private:
     SDL_Window* window;
     SDL_Renderer* renderer;
     AudioGenerator* audioGenerator;
-    SynthParams* params;
+    SynthParamsBuffer* params;
 
     bool osc1_enabled;
     bool osc2_enabled;
@@ -44,9 +56,28 @@ private:
     float osc1_freq_offset;
     float osc2_freq_offset;
     float osc3_freq_offset;
+    int osc1_unison;
+    int osc2_unison;
+    int osc3_unison;
+    float osc1_unison_detune;
+    float osc2_unison_detune;
+    float osc3_unison_detune;
+    float osc1_unison_spread;
+    float osc2_unison_spread;
+    float osc3_unison_spread;
+    int fm_algorithm;
+    float osc2_mod_index;
+    float osc3_mod_index;
     float osc_mix;
     float attack_time;
+    float decay_time;
+    float sustain_level;
     float release_time;
+    int envelope_curve;     // Envelope::Curve as int
+    int filter_type;        // FilterType as int
+    int filter_mode;        // StateVariableFilter::Mode as int
+    float filter_drive;
+    int filter_oversampling_index;  // 0 = 1x, 1 = 2x, 2 = 4x
     float filter_cutoff;
     float filter_resonance;
     float filter_auto_variation_frequency;
@@ -55,10 +86,20 @@ private:
     float volume;
     bool isNotePlaying;
     int octave;
-
+    int sample_rate_index;  // Index into SynthConstants::SUPPORTED_SAMPLE_RATES
+    int latency_profile;    // LatencyProfile as int
+    int voice_count;
+    int voice_steal_policy; // VoiceStealPolicy as int
+    int playing_notes[13];  // MIDI note sounding per piano key, -1 when up
+    int mouse_key;          // Piano key held with the mouse, 0 when none
+    char scale_path[256];          // Scala scale file, empty = equal temperament
+    char keyboard_map_path[256];   // Scala keyboard mapping, empty = default mapping
+    std::string tuning_status;     // Result of the last tuning load
 
     void handleKeyPress(int key);
-    void handleKeyRelease();
+    void handleKeyRelease(int key);
+    // Publish the current UI parameter values as one snapshot to the audio thread
+    void publishParams();
 };
 
 #endif //TESTINSTRUCT_MAINWINDOW_H 
\ No newline at end of file
@@ -1,12 +1,34 @@
 #include <iostream>
 #include <memory>
+#include <cstdlib>
+#include <cstring>
 #include "audio/include/AudioGenerator.h"
 #include "gui/include/MainWindow.h"
-#include "audio/include/SynthParams.h"
+#include "audio/include/SynthParamsBuffer.h"
 
-int main() {
-    // Create synthesizer parameters
-    SynthParams params;
+// Parse startup audio options: --rate <Hz> and --latency low|balanced|powersave
+static AudioConfig parseAudioConfig(int argc, char* argv[]) {
+    AudioConfig config;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::strcmp(argv[i], "--rate") == 0) {
+            config.sampleRate = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--latency") == 0) {
+            const char* profile = argv[++i];
+            if (std::strcmp(profile, "low") == 0) config.latency = LatencyProfile::LowLatency;
+            else if (std::strcmp(profile, "powersave") == 0) config.latency = LatencyProfile::PowerSave;
+            else config.latency = LatencyProfile::Balanced;
+        }
+    }
+    if (config.sampleRate <= 0.0) {
+        std::cerr << "Invalid sample rate, using " << SynthConstants::DEFAULT_SAMPLE_RATE << " Hz" << std::endl;
+        config.sampleRate = SynthConstants::DEFAULT_SAMPLE_RATE;
+    }
+    return config;
+}
+
+int main(int argc, char* argv[]) {
+    // Create the parameter buffer shared by the UI (writer) and the audio thread (reader)
+    SynthParamsBuffer params;
     // Create main window
     MainWindow mainWindow;
     // Set parameters in main window
@@ -16,7 +38,7 @@ int main() {
 
     // Initialize window and audio
     mainWindow.init();
-    audioGenerator->init();
+    audioGenerator->init(parseAudioConfig(argc, argv));
 
     // Set audio generator in main window
     mainWindow.setAudioGenerator(audioGenerator);
@@ -0,0 +1,147 @@
+// KernelIdentityTest.cpp
+// synth_test_kernels: every SIMD kernel this CPU supports (oscillator wavetable and
+// unison kernels, ladder filter kernel) must be bit-identical to its scalar reference,
+// so a render does not depend on the machine it runs on
+// Prints the first mismatch and exits with status 1
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "OscillatorKernels.h"
+#include "Wavetable.h"
+#include "LadderFilter.h"
+
+namespace {
+
+// Instruction sets with a kernel this CPU can run, scalar first
+std::vector<OscillatorKernels::Isa> supportedIsas() {
+    std::vector<OscillatorKernels::Isa> isas;
+    for (int i = 0; i <= static_cast<int>(OscillatorKernels::detectIsa()); i++) {
+        isas.push_back(static_cast<OscillatorKernels::Isa>(i));
+    }
+    return isas;
+}
+
+// Compare every supported SIMD kernel with the scalar reference, bit for bit,
+// over all shapes, every mip level, awkward start phases and block lengths
+bool kernelsMatchScalar() {
+    const uint32_t steps[] = { 42950u, 39403540u, 314075000u, 1331439862u, 2147054157u };
+    const uint32_t phases[] = { 0u, 1288490189u, 4294967295u };
+    const int counts[] = { 1, 3, 4, 15, 16, 17, 63, 64, 1000 };
+    std::vector<float> expected(1000), actual(1000);
+    std::vector<uint32_t> modulation(1000);
+    for (size_t i = 0; i < modulation.size(); i++) {
+        modulation[i] = static_cast<uint32_t>(i) * 2654435761u;  // Scattered offsets, every bit exercised
+    }
+    const uint32_t* const offsetSets[] = { nullptr, modulation.data() };  // Unmodulated and phase-modulated
+
+    for (OscillatorKernels::Isa isa : supportedIsas()) {
+        OscillatorKernels::TableKernel kernel = OscillatorKernels::tableKernel(isa);
+        for (int s = 0; s < static_cast<int>(Wavetable::Shape::Count); s++) {
+            for (uint32_t step : steps) {
+                const float* table = Wavetable::instance().select(static_cast<Wavetable::Shape>(s),
+                                                                  static_cast<double>(step) / SynthConstants::PHASE_CYCLE);
+                for (uint32_t phase : phases) {
+                    for (int count : counts) {
+                        for (const uint32_t* offsets : offsetSets) {
+                            uint32_t expectedPhase = OscillatorKernels::renderTableScalar(table, phase, step, offsets, 0.5f, expected.data(), count);
+                            uint32_t actualPhase = kernel(table, phase, step, offsets, 0.5f, actual.data(), count);
+                            if (std::memcmp(expected.data(), actual.data(), count * sizeof(float)) != 0
+                                || expectedPhase != actualPhase) {
+                                std::fprintf(stderr, "%s kernel differs from scalar (shape %d, step %u, phase %u, count %d%s)\n",
+                                             OscillatorKernels::isaName(isa), s, step, phase, count, offsets ? ", modulated" : "");
+                                return false;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Unison stacks, panned (both outputs) and centred (left output only)
+    const int stackSizes[] = { 2, 7, SynthConstants::MAX_UNISON };
+    std::vector<float> expectedRight(1000), actualRight(1000);
+    for (OscillatorKernels::Isa isa : supportedIsas()) {
+        OscillatorKernels::UnisonKernel kernel = OscillatorKernels::unisonKernel(isa);
+        const float* table = Wavetable::instance().select(Wavetable::Shape::Saw, static_cast<double>(steps[2]) / SynthConstants::PHASE_CYCLE);
+        for (int voices : stackSizes) {
+            uint32_t stackSteps[SynthConstants::MAX_UNISON];
+            uint32_t expectedPhases[SynthConstants::MAX_UNISON];
+            uint32_t actualPhases[SynthConstants::MAX_UNISON];
+            float gainsLeft[SynthConstants::MAX_UNISON];
+            float gainsRight[SynthConstants::MAX_UNISON];
+            for (int v = 0; v < voices; v++) {
+                stackSteps[v] = steps[2] + 1000003u * static_cast<uint32_t>(v);
+                expectedPhases[v] = actualPhases[v] = phases[1] * static_cast<uint32_t>(v + 1);
+                gainsLeft[v] = 0.1f + 0.03f * static_cast<float>(v);
+                gainsRight[v] = 0.6f - 0.03f * static_cast<float>(v);
+            }
+            for (bool stereo : { true, false }) {
+                for (int count : counts) {
+                    const uint32_t* offsets = stereo ? modulation.data() : nullptr;
+                    OscillatorKernels::renderUnisonScalar(table, expectedPhases, stackSteps, offsets, gainsLeft, gainsRight, voices,
+                                                          expected.data(), stereo ? expectedRight.data() : nullptr, count);
+                    kernel(table, actualPhases, stackSteps, offsets, gainsLeft, gainsRight, voices,
+                           actual.data(), stereo ? actualRight.data() : nullptr, count);
+                    if (std::memcmp(expected.data(), actual.data(), count * sizeof(float)) != 0
+                        || (stereo && std::memcmp(expectedRight.data(), actualRight.data(), count * sizeof(float)) != 0)
+                        || std::memcmp(expectedPhases, actualPhases, voices * sizeof(uint32_t)) != 0) {
+                        std::fprintf(stderr, "%s unison kernel differs from scalar (voices %d, count %d)\n",
+                                     OscillatorKernels::isaName(isa), voices, count);
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+
+    // Ladder filter kernels: half and full banks, every oversampling factor, hard driven
+    // and resonant so the saturation clamps, with the cutoff moving every sample
+    std::vector<float> ladderInput(1000 * LadderKernels::LANES);
+    std::vector<LadderKernels::Coefficients> ladderCoefficients(1000);
+    for (size_t i = 0; i < ladderInput.size(); i++) {
+        ladderInput[i] = std::sin(0.37f * static_cast<float>(i)) * (1.0f + static_cast<float>(i % 7));
+    }
+    for (size_t i = 0; i < ladderCoefficients.size(); i++) {
+        float g = 0.05f + 0.4f * static_cast<float>(i) / 1000.0f;
+        float oneMinusG = 1.0f - g;
+        ladderCoefficients[i] = { g, oneMinusG, { g * g * g * oneMinusG, g * g * oneMinusG, g * oneMinusG },
+                                  1.0f / (1.0f + 3.9f * (g * g) * (g * g)) };
+    }
+    for (OscillatorKernels::Isa isa : supportedIsas()) {
+        LadderKernels::Kernel kernel = LadderKernels::kernel(isa);
+        for (int lanes : { LadderKernels::LANE_GROUP, LadderKernels::LANES }) {
+            for (int oversampling : { 1, 2, 4 }) {
+                for (int count : counts) {
+                    const LadderKernels::Settings settings { 3.9f, 4.0f, oversampling };
+                    LadderKernels::State expectedState {};
+                    LadderKernels::State actualState {};
+                    std::vector<float> expectedFrames(ladderInput.begin(), ladderInput.begin() + count * LadderKernels::LANES);
+                    alignas(32) float actualFrames[1000 * LadderKernels::LANES];
+                    std::memcpy(actualFrames, expectedFrames.data(), expectedFrames.size() * sizeof(float));
+                    LadderKernels::processScalar(expectedState, ladderCoefficients.data(), settings, expectedFrames.data(), count, lanes);
+                    kernel(actualState, ladderCoefficients.data(), settings, actualFrames, count, lanes);
+                    if (std::memcmp(expectedFrames.data(), actualFrames, expectedFrames.size() * sizeof(float)) != 0
+                        || std::memcmp(&expectedState, &actualState, sizeof(LadderKernels::State)) != 0) {
+                        std::fprintf(stderr, "%s ladder kernel differs from scalar (lanes %d, oversampling %d, count %d)\n",
+                                     OscillatorKernels::isaName(isa), lanes, oversampling, count);
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    if (!kernelsMatchScalar()) {
+        return 1;
+    }
+    std::printf("kernels match scalar: %s and narrower\n", OscillatorKernels::isaName(OscillatorKernels::detectIsa()));
+    return 0;
+}
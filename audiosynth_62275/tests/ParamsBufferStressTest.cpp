@@ -0,0 +1,129 @@
+// ParamsBufferStressTest.cpp
+// synth_test_params_buffer: one writer thread publishes numbered SynthParams snapshots
+// as fast as it can while the reader (this thread) reads them, as the GUI and audio
+// threads do. Every snapshot read must be whole (all of its stamped fields from the
+// same publish), numbers must never go backwards, and the last publish must arrive.
+// Each read() is also timed: the audio callback relies on it never waiting for the
+// writer, so nearly all reads must be quick even while the writer publishes flat out
+// Prints the first violation and exits with status 1
+// Also worth running in a -fsanitize=thread build, which checks the memory ordering
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include "SynthParamsBuffer.h"
+
+namespace {
+
+constexpr int PUBLISHES = 1000000;
+
+// Both sides yield now and then, at co-prime intervals, so the two threads also
+// interleave at varying points on a machine with fewer cores than threads
+constexpr int WRITER_YIELD_INTERVAL = 97;
+constexpr int READER_YIELD_INTERVAL = 61;
+
+// Bounds on read() time, loose enough for any machine: nearly all reads within 64 us
+// (they take well under a microsecond), and the worst case within a scheduler time
+// slice, since the reader can be preempted mid-read when cores are short
+constexpr double READ_PERCENTILE = 0.999;
+constexpr int64_t PERCENTILE_READ_BOUND_NS = 65536;
+constexpr int64_t WORST_READ_BOUND_NS = 50000000;
+
+// Read times by power of two: bucket b counts reads under 2^b ns
+constexpr int TIME_BUCKETS = 64;
+
+// Stamp a snapshot with its number in fields spread over the whole struct
+void stamp(SynthParams& params, int number) {
+    params.attack = static_cast<float>(number & 0xFFFF);
+    params.filter_type = number;
+    params.volume = static_cast<float>(number & 0xFFFF);
+    params.osc3_unison_spread = static_cast<float>(number & 0xFFFF);
+    params.voice_count = number;
+    params.osc_mix = static_cast<float>(number & 0xFFFF);
+}
+
+// True if every stamped field carries the same number
+bool isWhole(const SynthParams& params) {
+    int number = params.voice_count;
+    auto low = static_cast<float>(number & 0xFFFF);
+    return params.filter_type == number && params.attack == low && params.volume == low
+           && params.osc3_unison_spread == low && params.osc_mix == low;
+}
+
+} // namespace
+
+int main() {
+    SynthParamsBuffer buffer;
+    SynthParams initial;
+    stamp(initial, 0);
+    buffer.publish(initial);
+
+    std::atomic<bool> start { false };
+    std::thread writer([&] {
+        while (!start.load(std::memory_order_acquire)) {}
+        SynthParams params;
+        for (int number = 1; number <= PUBLISHES; number++) {
+            stamp(params, number);
+            buffer.publish(params);
+            if (number % WRITER_YIELD_INTERVAL == 0) std::this_thread::yield();
+        }
+    });
+
+    start.store(true, std::memory_order_release);
+    int last = 0;
+    long reads = 0;
+    long changes = 0;
+    bool ok = true;
+    long readTimes[TIME_BUCKETS] = {};
+    int64_t worst = 0;
+    while (last < PUBLISHES) {
+        auto before = std::chrono::steady_clock::now();
+        const SynthParams& params = buffer.read();
+        int64_t nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - before).count();
+        readTimes[std::bit_width(static_cast<uint64_t>(nanos))]++;
+        worst = std::max(worst, nanos);
+        reads++;
+        if (!isWhole(params)) {
+            std::fprintf(stderr, "torn snapshot after #%d: voice_count %d, filter_type %d, volume %g\n",
+                         last, params.voice_count, params.filter_type, params.volume);
+            ok = false;
+            break;
+        }
+        if (params.voice_count < last) {
+            std::fprintf(stderr, "snapshot went backwards: #%d after #%d\n", params.voice_count, last);
+            ok = false;
+            break;
+        }
+        if (params.voice_count != last) changes++;
+        last = params.voice_count;
+        if (reads % READER_YIELD_INTERVAL == 0) std::this_thread::yield();
+    }
+    writer.join();
+
+    if (!ok) {
+        return 1;
+    }
+
+    // Smallest power of two that READ_PERCENTILE of the reads came in under
+    int bucket = 0;
+    for (long counted = readTimes[0]; counted < static_cast<long>(READ_PERCENTILE * static_cast<double>(reads)); ) {
+        counted += readTimes[++bucket];
+    }
+    int64_t percentile = int64_t { 1 } << bucket;
+    std::printf("params buffer: %d publishes, %ld reads, %ld distinct snapshots seen, all whole and in order\n",
+                PUBLISHES, reads, changes);
+    std::printf("read(): %.1f%% under %lld ns, worst %lld ns\n", READ_PERCENTILE * 100.0,
+                static_cast<long long>(percentile), static_cast<long long>(worst));
+    if (percentile > PERCENTILE_READ_BOUND_NS || worst > WORST_READ_BOUND_NS) {
+        std::fprintf(stderr, "read() too slow: %.1f%% must be under %lld ns and all under %lld ns\n",
+                     READ_PERCENTILE * 100.0, static_cast<long long>(PERCENTILE_READ_BOUND_NS),
+                     static_cast<long long>(WORST_READ_BOUND_NS));
+        return 1;
+    }
+    return 0;
+}
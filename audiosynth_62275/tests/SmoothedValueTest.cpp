@@ -0,0 +1,147 @@
+// SmoothedValueTest.cpp
+// synth_test_smoothing: SmoothedValue ramps land exactly on their target in the smoothing
+// time, give the same values however the samples are split between fill() and advance(),
+// and a settled value stays settled when the sample rate changes (as when the stream is
+// reopened at another rate); then the same through SynthEngine's smoothed volume
+// Prints every failed check and exits with status 1
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "SmoothedValue.h"
+#include "SynthEngine.h"
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        std::fprintf(stderr, "FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+SmoothedValue makeValue(SmoothedValue::Curve curve, float sampleRate) {
+    SmoothedValue value(0.0f, curve);
+    value.setSampleRate(sampleRate);
+    value.setSmoothingTime(0.01f);
+    return value;
+}
+
+// Ramps end on the target after exactly the smoothing time, and not before
+void checkRampLength(SmoothedValue::Curve curve) {
+    SmoothedValue value = makeValue(curve, 48000.0f);
+    check(!value.isSmoothing(), "a new value is settled");
+    value.setTarget(1.0f);
+    check(value.isSmoothing(), "a new target starts a ramp");
+    value.advance(479);
+    check(value.isSmoothing() && value.getCurrent() != 1.0f, "the ramp is still running one sample early");
+    value.advance(1);
+    check(!value.isSmoothing() && value.getCurrent() == 1.0f, "the ramp lands exactly on the target");
+    value.setTarget(1.0f);
+    check(!value.isSmoothing(), "an unchanged target does not start a ramp");
+}
+
+// fill() and advance() land on the same values whatever the split
+void checkSplits(SmoothedValue::Curve curve) {
+    SmoothedValue whole = makeValue(curve, 48000.0f);
+    SmoothedValue pieces = makeValue(curve, 48000.0f);
+    whole.setTarget(-3.0f);
+    pieces.setTarget(-3.0f);
+    std::vector<float> expected(600), actual(600);
+    whole.fill(expected.data(), 600);
+    const int splits[] = { 1, 63, 7, 100, 64, 13 };
+    int done = 0;
+    for (int i = 0; done < 600; i++) {
+        int count = std::min(splits[i % 6], 600 - done);
+        if (i % 3 == 2) {
+            std::fill(actual.begin() + done, actual.begin() + done + count - 1, 0.0f);
+            actual[done + count - 1] = pieces.advance(count);
+        } else {
+            pieces.fill(actual.data() + done, count);
+        }
+        check(actual[done + count - 1] == expected[done + count - 1], "split ramps land on the same values");
+        done += count;
+    }
+}
+
+// A settled value stays settled and on its target across a rate change either way,
+// and a ramp running at the change keeps its length
+void checkRateChange(SmoothedValue::Curve curve) {
+    for (float newRate : { 96000.0f, 24000.0f }) {
+        SmoothedValue value = makeValue(curve, 48000.0f);
+        value.setTarget(0.5f);
+        value.advance(480);
+        value.setSampleRate(newRate);
+        check(!value.isSmoothing(), "a settled value stays settled after a rate change");
+        float values[64];
+        value.fill(values, 64);
+        check(std::all_of(values, values + 64, [](float v) { return v == 0.5f; }),
+              "a settled value stays on its target after a rate change");
+
+        SmoothedValue moving = makeValue(curve, 48000.0f);
+        moving.setTarget(1.0f);
+        moving.advance(100);
+        moving.setSampleRate(newRate);
+        moving.advance(379);
+        check(moving.isSmoothing(), "a running ramp keeps its length across a rate change");
+        moving.advance(1);
+        check(!moving.isSmoothing() && moving.getCurrent() == 1.0f, "a ramp across a rate change lands on its target");
+        moving.setTarget(0.0f);
+        moving.advance(static_cast<int>(newRate / 100.0f) - 1);
+        check(moving.isSmoothing(), "the next ramp takes the smoothing time at the new rate");
+        check(moving.advance(1) == 0.0f && !moving.isSmoothing(), "the next ramp lands on its target at the new rate");
+    }
+}
+
+// Peak output of a held note over 'frames' frames
+float peak(SynthEngine& engine, int frames) {
+    std::vector<float> out(SynthConstants::FRAMES_PER_BUFFER * 2);
+    float level = 0.0f;
+    for (int done = 0; done < frames; done += SynthConstants::FRAMES_PER_BUFFER) {
+        engine.render(out.data(), SynthConstants::FRAMES_PER_BUFFER);
+        for (float sample : out) level = std::max(level, std::fabs(sample));
+    }
+    return level;
+}
+
+// The engine's smoothed volume holds its level when the stream is reopened at another rate
+void checkEngineRateChange() {
+    for (double newRate : { 96000.0, 44100.0 }) {
+        SynthParamsBuffer params;
+        SynthParams patch;
+        patch.attack = 0.001f;
+        patch.volume = 0.25f;
+        params.publish(patch);
+        SynthEngine engine(&params, 48000.0);
+        SynthEvent noteOn { SynthEvent::Type::NoteOn };
+        noteOn.note = 57;
+        engine.postEvent(noteOn);
+
+        peak(engine, 24000);
+        float before = peak(engine, 24000);
+        engine.setSampleRate(newRate);
+        float after = peak(engine, static_cast<int>(newRate / 2.0));
+        check(before > 0.1f && std::fabs(after - before) < 0.05f * before,
+              "the engine volume holds its level across a sample rate change");
+    }
+}
+
+} // namespace
+
+int main() {
+    for (SmoothedValue::Curve curve : { SmoothedValue::Curve::Linear, SmoothedValue::Curve::OnePole }) {
+        checkRampLength(curve);
+        checkSplits(curve);
+        checkRateChange(curve);
+    }
+    checkEngineRateChange();
+
+    if (failures > 0) {
+        return 1;
+    }
+    std::printf("smoothing: ramps exact, split-invariant and stable across sample rate changes\n");
+    return 0;
+}
@@ -0,0 +1,204 @@
+// OfflineRender.cpp
+// synth_render: renders a patch and a note script to a WAV file through the
+// same SynthEngine the PortAudio callback drives, as fast as the CPU allows
+//
+// Usage: synth_render <patch> <script> <out.wav> [--rate Hz] [--block frames] [--tail seconds]
+//                     [--compare reference.wav] [--tolerance max-abs-error] [--budget ms]
+//
+// Regression mode: with --compare the render is checked sample by sample against a
+// stored reference and the exit status is non-zero if any sample differs by more
+// than the tolerance (exit 2) or the render took longer than the budget (exit 3).
+// Renders are deterministic: noise comes from per-oscillator generators seeded by
+// the patch 'seed' key.
+//
+// Notes are pitched by the patch's tuning: equal temperament (A4 = 440 Hz) unless
+// the patch names Scala 'scale' / 'keyboard_mapping' files
+//
+// Note script: one event per line, '#' starts a comment
+//   <time in seconds> on <MIDI note>
+//   <time in seconds> off [MIDI note]     (no note = release every voice)
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "SynthEngine.h"
+#include "Patch.h"
+#include "include/WavFile.h"
+
+namespace {
+
+// One note event read from the script
+struct ScriptEvent {
+    double time;    // Seconds from the start of the render
+    bool noteOn;    // true = on, false = off
+    int note;       // MIDI note number (-1 on note-off = all notes)
+};
+
+// Load the note script; returns false and describes the problem in error
+bool loadScript(const std::string& path, std::vector<ScriptEvent>& events, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open note script " + path;
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        std::istringstream in(line.substr(0, line.find('#')));
+        ScriptEvent event { 0.0, false, 0 };
+        std::string kind;
+        if (!(in >> event.time)) {
+            continue;  // Blank or comment-only line
+        }
+        if (!(in >> kind) || (kind != "on" && kind != "off") || event.time < 0.0
+            || (kind == "on" && !(in >> event.note))) {
+            error = path + ":" + std::to_string(lineNumber) + ": expected '<seconds> on <note>' or '<seconds> off [note]'";
+            return false;
+        }
+        if (kind == "off" && !(in >> event.note)) {
+            event.note = -1;
+        }
+        event.noteOn = kind == "on";
+        events.push_back(event);
+    }
+
+    // Events are applied in time order
+    std::stable_sort(events.begin(), events.end(),
+                     [](const ScriptEvent& a, const ScriptEvent& b) { return a.time < b.time; });
+    return true;
+}
+
+void printUsage() {
+    std::fprintf(stderr, "usage: synth_render <patch> <script> <out.wav> [--rate Hz] [--block frames] [--tail seconds]\n"
+                         "                    [--compare reference.wav] [--tolerance max-abs-error] [--budget ms]\n");
+}
+
+// Compare a render with a reference file; prints the result, returns false on mismatch
+bool compareWithReference(const std::vector<float>& output, int sampleRate,
+                          const std::string& referencePath, double tolerance) {
+    std::vector<float> reference;
+    int channels = 0;
+    int referenceRate = 0;
+    if (!WavFile::read(referencePath, reference, channels, referenceRate)) {
+        std::printf("compare: cannot read reference %s\n", referencePath.c_str());
+        return false;
+    }
+    if (channels != 2 || referenceRate != sampleRate || reference.size() != output.size()) {
+        std::printf("compare: FAIL, format differs (reference %d ch, %d Hz, %zu frames; render 2 ch, %d Hz, %zu frames)\n",
+                    channels, referenceRate, reference.size() / std::max(channels, 1), sampleRate, output.size() / 2);
+        return false;
+    }
+
+    double maxError = 0.0;
+    size_t worst = 0;
+    for (size_t i = 0; i < output.size(); i++) {
+        double error = std::fabs(static_cast<double>(output[i]) - reference[i]);
+        if (error > maxError || std::isnan(error)) {
+            maxError = std::isnan(error) ? INFINITY : error;
+            worst = i;
+        }
+    }
+    bool pass = maxError <= tolerance;
+    std::printf("compare: %s, max abs error %.3g at frame %zu (tolerance %.3g)\n",
+                pass ? "PASS" : "FAIL", maxError, worst / 2, tolerance);
+    return pass;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        printUsage();
+        return 1;
+    }
+    const std::string patchPath = argv[1];
+    const std::string scriptPath = argv[2];
+    const std::string outputPath = argv[3];
+
+    double rateOverride = 0.0;
+    unsigned long blockSize = SynthConstants::FRAMES_PER_BUFFER;
+    double tail = 1.0;  // Seconds rendered after the last event, for release and filter ring-out
+    std::string referencePath;
+    double tolerance = 1e-6;
+    double budgetMs = 0.0;  // 0 = no render-time budget
+    for (int i = 4; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--rate") == 0) rateOverride = std::atof(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--block") == 0) blockSize = std::strtoul(argv[i + 1], nullptr, 10);
+        else if (std::strcmp(argv[i], "--tail") == 0) tail = std::atof(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--compare") == 0) referencePath = argv[i + 1];
+        else if (std::strcmp(argv[i], "--tolerance") == 0) tolerance = std::atof(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--budget") == 0) budgetMs = std::atof(argv[i + 1]);
+        else { printUsage(); return 1; }
+    }
+
+    Patch patch;
+    std::vector<ScriptEvent> script;
+    std::string error;
+    if (!patch.load(patchPath, error) || !loadScript(scriptPath, script, error)) {
+        std::fprintf(stderr, "synth_render: %s\n", error.c_str());
+        return 1;
+    }
+    if (rateOverride > 0.0) patch.sampleRate = rateOverride;
+    if (blockSize == 0 || patch.sampleRate <= 0.0) {
+        printUsage();
+        return 1;
+    }
+
+    SynthParamsBuffer params;
+    SynthEngine engine(&params, patch.sampleRate);
+    patch.apply(engine, params);
+
+    const double lastEvent = script.empty() ? 0.0 : script.back().time;
+    const auto totalFrames = static_cast<uint64_t>(std::ceil((lastEvent + tail) * patch.sampleRate));
+    std::vector<float> output(totalFrames * 2);
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Feed script events one block ahead; the engine applies them at their exact frame
+    size_t nextEvent = 0;
+    for (uint64_t frame = 0; frame < totalFrames; frame += blockSize) {
+        unsigned long frames = static_cast<unsigned long>(std::min<uint64_t>(blockSize, totalFrames - frame));
+        while (nextEvent < script.size()) {
+            const ScriptEvent& e = script[nextEvent];
+            auto eventFrame = static_cast<uint64_t>(std::llround(e.time * patch.sampleRate));
+            if (eventFrame >= frame + frames) break;
+            SynthEvent event { e.noteOn ? SynthEvent::Type::NoteOn : SynthEvent::Type::NoteOff };
+            event.frame = eventFrame;
+            event.note = e.note;
+            if (!engine.postEvent(event)) break;  // Queue full: retry on the next block
+            nextEvent++;
+        }
+        engine.render(output.data() + frame * 2, frames);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double audioSeconds = static_cast<double>(totalFrames) / patch.sampleRate;
+
+    if (!WavFile::write(outputPath, output, 2, static_cast<int>(patch.sampleRate))) {
+        std::fprintf(stderr, "synth_render: cannot write %s\n", outputPath.c_str());
+        return 1;
+    }
+    std::printf("rendered %.2f s of audio in %.3f s (%.1fx realtime) -> %s\n",
+                audioSeconds, seconds, audioSeconds / std::max(seconds, 1e-9), outputPath.c_str());
+
+    bool matches = referencePath.empty()
+                   || compareWithReference(output, static_cast<int>(patch.sampleRate), referencePath, tolerance);
+    bool withinBudget = true;
+    if (budgetMs > 0.0) {
+        withinBudget = seconds * 1000.0 <= budgetMs;
+        std::printf("budget: %s, %.3f ms of %.3f ms\n", withinBudget ? "PASS" : "FAIL", seconds * 1000.0, budgetMs);
+    }
+    if (!matches) return 2;
+    if (!withinBudget) return 3;
+    return 0;
+}
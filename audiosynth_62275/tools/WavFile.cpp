@@ -0,0 +1,92 @@
+#include "include/WavFile.h"
+#include <cstdint>
+#include <fstream>
+
+namespace {
+
+// Append a little-endian integer of the given byte width
+void putLE(std::ofstream& out, uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+// Decode a little-endian integer of the given byte width
+uint32_t getLE(const char* data, int bytes) {
+    uint32_t value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= static_cast<uint32_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+    }
+    return value;
+}
+
+} // namespace
+
+// Write interleaved samples, returns false if the file cannot be written
+bool WavFile::write(const std::string& path, const std::vector<float>& samples, int channels, int sampleRate) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        return false;
+    }
+
+    const uint32_t dataBytes = static_cast<uint32_t>(samples.size() * sizeof(float));
+    const uint32_t blockAlign = static_cast<uint32_t>(channels * sizeof(float));
+
+    // RIFF header
+    out.write("RIFF", 4);
+    putLE(out, 36 + dataBytes, 4);
+    out.write("WAVE", 4);
+
+    // Format chunk: IEEE float, interleaved
+    out.write("fmt ", 4);
+    putLE(out, 16, 4);
+    putLE(out, 3, 2);                            // WAVE_FORMAT_IEEE_FLOAT
+    putLE(out, static_cast<uint32_t>(channels), 2);
+    putLE(out, static_cast<uint32_t>(sampleRate), 4);
+    putLE(out, static_cast<uint32_t>(sampleRate) * blockAlign, 4);
+    putLE(out, blockAlign, 2);
+    putLE(out, 32, 2);                           // Bits per sample
+
+    // Sample data (little-endian hosts write floats as-is)
+    out.write("data", 4);
+    putLE(out, dataBytes, 4);
+    out.write(reinterpret_cast<const char*>(samples.data()), dataBytes);
+
+    return static_cast<bool>(out);
+}
+
+// Read a file written by write(); returns false if it is missing or not 32-bit float
+bool WavFile::read(const std::string& path, std::vector<float>& samples, int& channels, int& sampleRate) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    char header[12];
+    if (!in.read(header, 12) || std::string(header, 4) != "RIFF" || std::string(header + 8, 4) != "WAVE") {
+        return false;
+    }
+
+    // Walk the chunks: 'fmt ' must come before 'data'
+    bool haveFormat = false;
+    char chunk[8];
+    while (in.read(chunk, 8)) {
+        const std::string id(chunk, 4);
+        const uint32_t size = getLE(chunk + 4, 4);
+        if (id == "fmt ") {
+            std::vector<char> format(size);
+            if (size < 16 || !in.read(format.data(), size)) return false;
+            if (getLE(format.data(), 2) != 3 || getLE(format.data() + 14, 2) != 32) return false;
+            channels = static_cast<int>(getLE(format.data() + 2, 2));
+            sampleRate = static_cast<int>(getLE(format.data() + 4, 4));
+            haveFormat = true;
+        } else if (id == "data" && haveFormat) {
+            samples.resize(size / sizeof(float));
+            return static_cast<bool>(in.read(reinterpret_cast<char*>(samples.data()),
+                                             static_cast<std::streamsize>(samples.size() * sizeof(float))));
+        } else {
+            in.seekg(size + (size & 1), std::ios::cur);  // Chunks are padded to even sizes
+        }
+    }
+    return false;
+}
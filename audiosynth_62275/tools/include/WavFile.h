@@ -0,0 +1,17 @@
+#ifndef AUDIOSYNTH_WAVFILE_H
+#define AUDIOSYNTH_WAVFILE_H
+
+#include <string>
+#include <vector>
+
+// Minimal WAV file support for the offline tools
+// Samples are interleaved 32-bit floats (WAVE_FORMAT_IEEE_FLOAT)
+namespace WavFile {
+    // Write interleaved samples, returns false if the file cannot be written
+    bool write(const std::string& path, const std::vector<float>& samples, int channels, int sampleRate);
+
+    // Read a file written by write(); returns false if it is missing or not 32-bit float
+    bool read(const std::string& path, std::vector<float>& samples, int& channels, int& sampleRate);
+} // namespace WavFile
+
+#endif // AUDIOSYNTH_WAVFILE_H